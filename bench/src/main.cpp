@@ -0,0 +1,491 @@
+#include <ini-cpp/ini.hpp>
+#include <ini-cpp/frozen_ini.hpp>
+#include <ini-cpp/parser.hpp>
+#include <ini-cpp/thread_pool.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <filesystem>
+#include <memory>
+#include <optional>
+#include <random>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <thread>
+#include <vector>
+
+/*
+ * Usage: ini-cpp-bench [--sizes=1K,1M,16M] [--corpora=small_sections,...] [--filter=read] [--samples=5] [--format=json|text]
+ *
+ * Every benchmark runs on every generated corpus. A sample repeats the operation until it takes a few milliseconds,
+ * and the best and median time per item of all samples are reported. The JSON goes to stdout, progress to stderr.
+ */
+
+namespace {
+    typedef std::chrono::steady_clock clock_type;
+
+    template<typename F>
+    inline double time(F&& f) {
+        auto const start = clock_type::now();
+        f();
+        return std::chrono::duration<double>(clock_type::now() - start).count();
+    }
+
+    // Keeps the results of lookup loops alive
+    volatile std::size_t sink;
+
+    enum class corpus_kind { small_sections, huge_sections, long_values, comments };
+
+    constexpr corpus_kind all_corpora[] = { corpus_kind::small_sections, corpus_kind::huge_sections, corpus_kind::long_values, corpus_kind::comments };
+
+    const char* name_of(corpus_kind kind) {
+        switch (kind) {
+        case corpus_kind::small_sections: return "small_sections";
+        case corpus_kind::huge_sections: return "huge_sections";
+        case corpus_kind::long_values: return "long_values";
+        case corpus_kind::comments: return "comments";
+        }
+        return "";
+    }
+
+    // Integers, decimals and text take turns, so that every corpus has values to convert
+    void append_value(std::string& out, std::size_t index, std::size_t text_length, std::mt19937_64& rng) {
+        switch (index % 3) {
+        case 0:
+            out += std::to_string(rng() % 1000000);
+            break;
+        case 1:
+            out += std::to_string(rng() % 100000) + "." + std::to_string(rng() % 1000);
+            break;
+        default:
+            for (std::size_t i = 0; i < text_length; i++) out += static_cast<char>('a' + rng() % 26);
+            break;
+        }
+    }
+
+    /*
+     * Generates a corpus of about `target` bytes:
+     *   small_sections  thousands of sections of four keys
+     *   huge_sections   four sections that share all the keys
+     *   long_values     sections of sixteen keys whose text values are 1 to 4 KB long
+     *   comments        a comment line before every key and inline comments after the text values
+     */
+    std::string generate(corpus_kind kind, std::size_t target) {
+        std::mt19937_64 rng(static_cast<std::uint64_t>(kind) + 1);
+        std::string out;
+        out.reserve(target + 8192);
+
+        static const char* const handles[] = { "# ", "; ", "// " };
+        std::size_t key = 0;
+        for (std::size_t section = 0; out.size() < target; section++) {
+            out += "[section" + std::to_string(section) + "]\n";
+
+            std::size_t const keys = kind == corpus_kind::small_sections ? 4 : kind == corpus_kind::long_values ? 16 : kind == corpus_kind::comments ? 64 : 0;
+            std::size_t const section_end = (section + 1) * target / 4;
+            for (std::size_t k = 0; kind == corpus_kind::huge_sections ? out.size() < section_end : k < keys && out.size() < target; k++, key++) {
+                if (kind == corpus_kind::comments) out.append(handles[key % 3]).append("the next key is number ").append(std::to_string(k)).append("\n");
+
+                out += "key" + std::to_string(k) + " = ";
+                append_value(out, k, kind == corpus_kind::long_values ? 1024 + rng() % 3072 : 16, rng);
+                if (kind == corpus_kind::comments && k % 3 == 2) out += " ; inline comment";
+                out += "\n";
+            }
+            out += "\n";
+        }
+        return out;
+    }
+
+    struct options {
+        std::vector<std::size_t> sizes = { std::size_t(1) << 10, std::size_t(1) << 20, std::size_t(16) << 20 };
+        std::vector<corpus_kind> corpora = { std::begin(all_corpora), std::end(all_corpora) };
+        std::string filter;
+        int samples = 5;
+        bool json = true;
+    };
+
+    struct result {
+        std::string corpus;
+        std::size_t size;
+        std::size_t bytes;
+        std::string benchmark;
+        std::size_t items;
+        std::size_t repeat;
+        double best_ns;
+        double median_ns;
+        double mb_per_s;
+    };
+
+    class runner {
+    public:
+        inline explicit runner(const options& opts) : m_options(opts) {}
+
+        inline void start_corpus(corpus_kind kind, std::size_t size, std::size_t bytes) {
+            m_corpus = name_of(kind);
+            m_size = size;
+            m_bytes = bytes;
+        }
+
+        /**
+         * Runs `body(repeat)`, which performs the operation `repeat` times and returns the seconds it spent on them.
+         * `items` is the number of items one operation handles, e.g. the number of lookups in a batch, and `bytes`
+         * the number of bytes it processes, or 0 if a throughput makes no sense.
+         */
+        template<typename Body>
+        void run(const char* name, std::size_t bytes, std::size_t items, Body&& body) {
+            if (!m_options.filter.empty() && std::string_view(name).find(m_options.filter) == std::string_view::npos) return;
+            std::fprintf(stderr, "%s/%zu: %s\n", m_corpus.c_str(), m_size, name);
+
+            // repeat until a sample is long enough for the clock, without letting the setup of huge corpora run away
+            constexpr double min_sample = 0.005;
+            constexpr std::size_t max_repeat = std::size_t(1) << 20;
+            std::size_t repeat = 1;
+            for (double seconds = body(repeat); seconds < min_sample && repeat < max_repeat; seconds = body(repeat)) {
+                std::size_t const factor = seconds > 0 ? std::clamp<std::size_t>(static_cast<std::size_t>(min_sample / seconds * 1.2), 2, 64) : 64;
+                repeat = std::min(repeat * factor, max_repeat);
+            }
+
+            std::vector<double> samples;
+            for (int i = 0; i < m_options.samples; i++) samples.push_back(body(repeat) / repeat);
+            std::sort(samples.begin(), samples.end());
+
+            double const best = samples.front(), median = samples[samples.size() / 2];
+            m_results.push_back({ m_corpus, m_size, m_bytes, name, items, repeat, best * 1e9 / items, median * 1e9 / items,
+                bytes ? bytes / best / (1024.0 * 1024.0) : 0.0 });
+        }
+
+        void print() const {
+            if (!m_options.json) {
+                std::printf("%-16s %10s  %-20s %14s %14s %12s\n", "corpus", "size", "benchmark", "best ns/item", "median ns/item", "MB/s");
+                for (auto const& r : m_results) {
+                    std::printf("%-16s %10zu  %-20s %14.1f %14.1f %12.1f\n", r.corpus.c_str(), r.bytes, r.benchmark.c_str(), r.best_ns, r.median_ns, r.mb_per_s);
+                }
+                return;
+            }
+
+#ifdef NDEBUG
+            constexpr bool assertions = false;
+#else
+            constexpr bool assertions = true;
+#endif
+            std::printf("{\n  \"library\": \"ini-cpp\",\n  \"compiler\": \"%s\",\n  \"cplusplus\": %ld,\n  \"assertions\": %s,\n  \"hardware_threads\": %u,\n",
+                compiler(), static_cast<long>(__cplusplus), assertions ? "true" : "false", std::thread::hardware_concurrency());
+            std::printf("  \"samples\": %d,\n  \"results\": [", m_options.samples);
+            for (std::size_t i = 0; i < m_results.size(); i++) {
+                auto const& r = m_results[i];
+                char throughput[32] = "null";
+                if (r.mb_per_s > 0) std::snprintf(throughput, sizeof(throughput), "%.2f", r.mb_per_s);
+                std::printf("%s\n    { \"corpus\": \"%s\", \"size\": %zu, \"bytes\": %zu, \"benchmark\": \"%s\", \"items\": %zu, \"repeat\": %zu, "
+                    "\"best_ns\": %.2f, \"median_ns\": %.2f, \"mb_per_s\": %s }", i ? "," : "", r.corpus.c_str(), r.size, r.bytes,
+                    r.benchmark.c_str(), r.items, r.repeat, r.best_ns, r.median_ns, throughput);
+            }
+            std::printf("\n  ]\n}\n");
+        }
+    private:
+        static const char* compiler() noexcept {
+#if defined(__clang__)
+            return "clang " __clang_version__;
+#elif defined(__GNUC__)
+            return "gcc " __VERSION__;
+#elif defined(_MSC_VER)
+            return "msvc";
+#else
+            return "unknown";
+#endif
+        }
+
+        const options& m_options;
+        std::string m_corpus;
+        std::size_t m_size = 0;
+        std::size_t m_bytes = 0;
+        std::vector<result> m_results;
+    };
+
+    // Counts keys without storing anything, the cost of the tokenizer alone
+    struct key_counter : inicpp::parse_handler {
+        std::size_t keys = 0;
+        void on_key_value(std::string_view, std::string_view) override { keys++; }
+    };
+
+    // Times `op` on a fresh ini per repetition. The ini is destroyed outside of the timed region.
+    template<typename Op>
+    double fresh_ini(std::size_t repeat, Op&& op) {
+        double total = 0;
+        for (std::size_t r = 0; r < repeat; r++) {
+            std::optional<inicpp::ini> target;
+            total += time([&] { op(target); });
+        }
+        return total;
+    }
+
+    void run_corpus(runner& bench, corpus_kind kind, std::size_t size, inicpp::thread_pool& pool) {
+        std::string const text = generate(kind, size);
+        std::string const id = std::to_string(static_cast<int>(kind)) + "-" + std::to_string(size);
+        std::filesystem::path const path = std::filesystem::temp_directory_path() / ("ini-cpp-bench-" + id + ".ini");
+        std::filesystem::path const cache = std::filesystem::temp_directory_path() / ("ini-cpp-bench-" + id + ".bin");
+
+        inicpp::ini loaded;
+        loaded.read(text);
+        loaded.write_file(path.string());
+        bench.start_corpus(kind, size, text.size());
+
+        bench.run("parse", text.size(), 1, [&](std::size_t repeat) {
+            return time([&] {
+                for (std::size_t r = 0; r < repeat; r++) {
+                    key_counter counter;
+                    inicpp::parse(text, counter);
+                    sink = counter.keys;
+                }
+            });
+        });
+
+        bench.run("read", text.size(), 1, [&](std::size_t repeat) {
+            return fresh_ini(repeat, [&](std::optional<inicpp::ini>& target) { target.emplace().read(text); });
+        });
+
+        bench.run("read_file", text.size(), 1, [&](std::size_t repeat) {
+            return fresh_ini(repeat, [&](std::optional<inicpp::ini>& target) { target.emplace().read_file(path.string()); });
+        });
+
+        bench.run("read_arena", text.size(), 1, [&](std::size_t repeat) {
+            return fresh_ini(repeat, [&](std::optional<inicpp::ini>& target) { target.emplace(inicpp::ini::with_arena()).read(text); });
+        });
+
+        bench.run("read_parallel", text.size(), 1, [&](std::size_t repeat) {
+            return fresh_ini(repeat, [&](std::optional<inicpp::ini>& target) { target.emplace().read_parallel(text, pool); });
+        });
+
+        // the first call writes the cache, so the samples measure hits
+        inicpp::frozen_ini::read_file_cached(path.string(), cache.string());
+        bench.run("read_cached", text.size(), 1, [&](std::size_t repeat) {
+            return time([&] {
+                for (std::size_t r = 0; r < repeat; r++) sink = inicpp::frozen_ini::read_file_cached(path.string(), cache.string()).size();
+            });
+        });
+
+        std::string written;
+        loaded.write(written);
+        bench.run("write", written.size(), 1, [&](std::size_t repeat) {
+            return time([&] {
+                for (std::size_t r = 0; r < repeat; r++) loaded.write(written);
+            });
+        });
+
+        bench.run("write_file", written.size(), 1, [&](std::size_t repeat) {
+            return time([&] {
+                for (std::size_t r = 0; r < repeat; r++) loaded.write_file(path.string());
+            });
+        });
+
+        bench.run("copy", text.size(), 1, [&](std::size_t repeat) {
+            return fresh_ini(repeat, [&](std::optional<inicpp::ini>& target) { target.emplace(loaded); });
+        });
+
+        bench.run("destroy", text.size(), 1, [&](std::size_t repeat) {
+            double total = 0;
+            for (std::size_t r = 0; r < repeat; r++) {
+                auto target = std::make_unique<inicpp::ini>(loaded);
+                total += time([&] { target.reset(); });
+            }
+            return total;
+        });
+
+        inicpp::frozen_ini const frozen = loaded.freeze();
+        bench.run("freeze", text.size(), 1, [&](std::size_t repeat) {
+            return time([&] {
+                for (std::size_t r = 0; r < repeat; r++) sink = loaded.freeze().storage_size();
+            });
+        });
+
+        // lookups are batches of names spread evenly over the corpus; misses alternate between missing keys and sections
+        std::vector<std::pair<std::string, std::string>> hits, misses;
+        std::vector<const inicpp::ini_value*> integers, decimals;
+        {
+            std::size_t total = 0, integer_count = 0, decimal_count = 0;
+            for (auto const& section : loaded) {
+                for (auto const& value : section) {
+                    total++;
+                    if (value.second.try_as<int>()) integer_count++;
+                    else if (value.second.try_as<double>()) decimal_count++;
+                }
+            }
+
+            auto const stride = [](std::size_t count) { return std::max<std::size_t>(1, count / 1024); };
+            std::size_t index = 0, integer_index = 0, decimal_index = 0;
+            for (auto const& section : loaded) {
+                for (auto const& value : section) {
+                    if (index++ % stride(total) == 0) {
+                        hits.emplace_back(section.get_name(), value.first);
+                        misses.emplace_back(misses.size() % 2 ? "missing" + section.get_name() : section.get_name(), "missing" + value.first);
+                    }
+                    if (value.second.try_as<int>()) {
+                        if (integer_index++ % stride(integer_count) == 0) integers.push_back(&value.second);
+                    } else if (value.second.try_as<double>()) {
+                        if (decimal_index++ % stride(decimal_count) == 0) decimals.push_back(&value.second);
+                    }
+                }
+            }
+        }
+
+        const inicpp::ini& lookup = loaded;
+        auto const lookups = [&](const char* name, const std::vector<std::pair<std::string, std::string>>& names) {
+            bench.run(name, 0, names.size(), [&](std::size_t repeat) {
+                return time([&] {
+                    std::size_t found = 0;
+                    for (std::size_t r = 0; r < repeat; r++) {
+                        for (auto const& n : names) found += lookup[n.first][n.second].has_value();
+                    }
+                    sink = found;
+                });
+            });
+        };
+        lookups("lookup_hit", hits);
+        lookups("lookup_miss", misses);
+
+        std::vector<inicpp::key_handle> handles;
+        for (auto const& n : hits) handles.push_back(lookup.handle(n.first, n.second));
+        bench.run("lookup_handle", 0, handles.size(), [&](std::size_t repeat) {
+            return time([&] {
+                std::size_t found = 0;
+                for (std::size_t r = 0; r < repeat; r++) {
+                    for (auto& handle : handles) found += lookup.try_get(handle) != nullptr;
+                }
+                sink = found;
+            });
+        });
+
+        bench.run("frozen_lookup_hit", 0, hits.size(), [&](std::size_t repeat) {
+            return time([&] {
+                std::size_t found = 0;
+                for (std::size_t r = 0; r < repeat; r++) {
+                    for (auto const& n : hits) found += frozen[n.first][n.second].has_value();
+                }
+                sink = found;
+            });
+        });
+
+        // repeated conversions of ini values are answered by their conversion cache; frozen values convert every time
+        auto const conversions = [&](const char* name, const std::vector<const inicpp::ini_value*>& values, auto type) {
+            typedef decltype(type) T;
+            if (values.empty()) return;
+            bench.run(name, 0, values.size(), [&](std::size_t repeat) {
+                return time([&] {
+                    T total{};
+                    for (std::size_t r = 0; r < repeat; r++) {
+                        for (auto value : values) total += value->as<T>();
+                    }
+                    sink = static_cast<std::size_t>(total);
+                });
+            });
+        };
+        conversions("as_int", integers, int());
+        conversions("as_double", decimals, double());
+
+        std::vector<std::string_view> integer_text, decimal_text;
+        for (auto value : integers) integer_text.push_back(value->get_value());
+        for (auto value : decimals) decimal_text.push_back(value->get_value());
+
+        auto const uncached = [&](const char* name, const std::vector<std::string_view>& texts, auto type) {
+            typedef decltype(type) T;
+            if (texts.empty()) return;
+            bench.run(name, 0, texts.size(), [&](std::size_t repeat) {
+                return time([&] {
+                    T total{};
+                    for (std::size_t r = 0; r < repeat; r++) {
+                        for (auto text : texts) total += inicpp::detail::convert<T>(text.data(), text.size());
+                    }
+                    sink = static_cast<std::size_t>(total);
+                });
+            });
+        };
+        uncached("as_int_uncached", integer_text, int());
+        uncached("as_double_uncached", decimal_text, double());
+
+        std::error_code ignored;
+        std::filesystem::remove(path, ignored);
+        std::filesystem::remove(cache, ignored);
+    }
+
+    bool parse_size(std::string_view text, std::size_t& out) {
+        char* end = nullptr;
+        std::string const copy(text);
+        unsigned long long value = std::strtoull(copy.c_str(), &end, 10);
+        if (end == copy.c_str()) return false;
+
+        switch (*end) {
+        case 'K': case 'k': value <<= 10; end++; break;
+        case 'M': case 'm': value <<= 20; end++; break;
+        case 'G': case 'g': value <<= 30; end++; break;
+        default: break;
+        }
+        out = static_cast<std::size_t>(value);
+        return *end == '\0' && value > 0;
+    }
+
+    std::vector<std::string_view> split(std::string_view list) {
+        std::vector<std::string_view> parts;
+        for (std::size_t start = 0; start <= list.size();) {
+            std::size_t const comma = std::min(list.find(',', start), list.size());
+            if (comma > start) parts.push_back(list.substr(start, comma - start));
+            start = comma + 1;
+        }
+        return parts;
+    }
+
+    bool parse_options(int argc, char** argv, options& opts) {
+        for (int i = 1; i < argc; i++) {
+            std::string_view const arg = argv[i];
+            auto const value = [&](std::string_view flag, std::string_view& out) {
+                if (arg.substr(0, flag.size()) != flag) return false;
+                out = arg.substr(flag.size());
+                return true;
+            };
+
+            std::string_view v;
+            if (value("--sizes=", v)) {
+                opts.sizes.clear();
+                for (auto part : split(v)) {
+                    std::size_t size;
+                    if (!parse_size(part, size)) return false;
+                    opts.sizes.push_back(size);
+                }
+            } else if (value("--corpora=", v)) {
+                opts.corpora.clear();
+                for (auto part : split(v)) {
+                    auto const f = std::find_if(std::begin(all_corpora), std::end(all_corpora), [&](corpus_kind kind) { return part == name_of(kind); });
+                    if (f == std::end(all_corpora)) return false;
+                    opts.corpora.push_back(*f);
+                }
+            } else if (value("--filter=", v)) {
+                opts.filter = std::string(v);
+            } else if (value("--samples=", v)) {
+                opts.samples = std::atoi(std::string(v).c_str());
+                if (opts.samples <= 0) return false;
+            } else if (value("--format=", v) && (v == "json" || v == "text")) {
+                opts.json = v == "json";
+            } else {
+                return false;
+            }
+        }
+        return !opts.sizes.empty() && !opts.corpora.empty();
+    }
+}
+
+int main(int argc, char** argv) {
+    options opts;
+    if (!parse_options(argc, argv, opts)) {
+        std::fprintf(stderr, "usage: %s [--sizes=1K,1M,16M] [--corpora=small_sections,huge_sections,long_values,comments] "
+            "[--filter=NAME] [--samples=5] [--format=json|text]\n", argv[0]);
+        return 2;
+    }
+
+    inicpp::thread_pool pool;
+    runner bench(opts);
+    for (auto kind : opts.corpora) {
+        for (auto size : opts.sizes) run_corpus(bench, kind, size, pool);
+    }
+    bench.print();
+}
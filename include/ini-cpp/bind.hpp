@@ -0,0 +1,239 @@
+#ifndef INICPP_BIND_H
+#define INICPP_BIND_H 1
+
+#include "config.h"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace inicpp {
+    /**
+     * @brief Maps the key @c name onto a data member of Struct. Created with @c make_field.
+     */
+    template<typename Struct, typename T>
+    struct field {
+        std::string_view name;
+        T Struct::* member;
+    };
+
+    template<typename Struct, typename T>
+    constexpr field<Struct, T> make_field(std::string_view name, T Struct::* member) noexcept { return { name, member }; }
+
+    namespace detail {
+        // FNV-1a, which is short enough to run at compile time and fast on key-sized strings
+        constexpr std::uint64_t field_hash(std::string_view name) noexcept {
+            std::uint64_t h = 0xcbf29ce484222325ull;
+            for (char c : name) {
+                h ^= static_cast<unsigned char>(c);
+                h *= 0x100000001b3ull;
+            }
+            return h;
+        }
+
+        template<typename T>
+        struct is_optional : std::false_type {};
+
+        template<typename T>
+        struct is_optional<std::optional<T>> : std::true_type {};
+    }
+
+    /**
+     * @brief The fields of a struct that @c bind fills from a section. The names are hashed into an open addressing table
+     * when the table is constructed, which happens at compile time for a @c constexpr table, so that binding a key costs
+     * one hash and one compare. Naming two fields alike makes the table fail to compile.
+     *
+     * Fields of type @c std::optional are optional: a missing key leaves them empty and is not reported.
+     */
+    template<typename Struct, typename... Ts>
+    class field_table {
+    public:
+        static constexpr std::size_t size = sizeof...(Ts);
+
+        constexpr explicit field_table(field<Struct, Ts>... fields) : m_fields(fields...), m_names{ fields.name... },
+            m_optional{ detail::is_optional<Ts>::value... } {
+            for (std::size_t i = 0; i < size; i++) {
+                for (std::size_t j = 0; j < i; j++) {
+                    if (m_names[i] == m_names[j]) throw std::logic_error("field_table: duplicate field name");
+                }
+
+                std::size_t slot = detail::field_hash(m_names[i]) & (slot_count - 1);
+                while (m_slots[slot] != 0) slot = (slot + 1) & (slot_count - 1);
+                m_slots[slot] = i + 1;
+            }
+        }
+
+        /**
+         * @brief Finds the field named @p name
+         * @return Its index, or @c size if there is none
+         */
+        constexpr std::size_t find(std::string_view name) const noexcept {
+            for (std::size_t slot = detail::field_hash(name) & (slot_count - 1);; slot = (slot + 1) & (slot_count - 1)) {
+                if (m_slots[slot] == 0) return size;
+                if (m_names[m_slots[slot] - 1] == name) return m_slots[slot] - 1;
+            }
+        }
+
+        constexpr std::string_view name(std::size_t index) const noexcept { return m_names[index]; }
+
+        constexpr bool is_optional(std::size_t index) const noexcept { return m_optional[index]; }
+
+        template<std::size_t I>
+        constexpr const auto& get() const noexcept { return std::get<I>(m_fields); }
+    private:
+        // at most half of the slots are taken, so a probe that misses ends quickly
+        static constexpr std::size_t slot_count = [] {
+            std::size_t count = 1;
+            while (count < 2 * size) count *= 2;
+            return count;
+        }();
+
+        std::tuple<field<Struct, Ts>...> m_fields;
+        std::array<std::string_view, size> m_names;
+        std::array<bool, size> m_optional;
+        std::array<std::size_t, slot_count> m_slots{};    // index of the field + 1, 0 for a free slot
+    };
+
+    /**
+     * @brief Declares the fields of Struct. Specialize it with a @c constexpr @c field_table named @c fields:
+     *
+     *     template<>
+     *     struct inicpp::binding<server_config> {
+     *         static constexpr inicpp::field_table fields{
+     *             inicpp::make_field("host", &server_config::host),
+     *             inicpp::make_field("port", &server_config::port),
+     *         };
+     *     };
+     */
+    template<typename Struct>
+    struct binding;
+
+    /**
+     * @brief Everything that did not fit while binding a section, reported together rather than one error at a time.
+     */
+    struct bind_result {
+        std::vector<std::string> missing;   // required fields without a key
+        std::vector<std::string> unknown;   // keys without a field
+        std::vector<std::string> invalid;   // keys whose value could not be converted to the type of their field
+
+        inline bool ok() const noexcept { return missing.empty() && unknown.empty() && invalid.empty(); }
+        inline explicit operator bool() const noexcept { return ok(); }
+    };
+
+    /**
+     * @brief Thrown by @c bind when a section does not match its struct. The message lists every problem, and
+     * @c result holds them for inspection.
+     */
+    class bind_exception : public std::runtime_error {
+    public:
+        inline bind_exception(std::string_view section, bind_result result);
+
+        inline const bind_result& result() const noexcept { return *m_result; }
+    private:
+        inline static std::string format(std::string_view section, const bind_result& result);
+
+        // shared, so that copying the exception cannot throw
+        std::shared_ptr<const bind_result> m_result;
+    };
+
+    namespace detail {
+        template<typename T, typename Value>
+        inline bool bind_value(T& member, const Value& value) {
+            if constexpr (is_optional<T>::value) {
+                typename T::value_type parsed{};
+                if (value.try_as(parsed) != std::errc()) return false;
+                member = std::move(parsed);
+                return true;
+            } else {
+                return value.try_as(member) == std::errc();
+            }
+        }
+
+        // The fold expands to a comparison per field, which the compiler turns into a jump on the index
+        template<typename Struct, typename Table, typename Value, std::size_t... I>
+        inline bool bind_field(const Table& table, std::size_t index, Struct& out, const Value& value, std::index_sequence<I...>) {
+            bool converted = false;
+            static_cast<void>(((index == I && (converted = bind_value(out.*table.template get<I>().member, value), true)) || ...));
+            return converted;
+        }
+    }
+
+    /**
+     * @brief Fills the fields of @p out declared by @c binding<Struct> from the keys of @p section, in one pass over the
+     * keys. Values are converted like @c ini_value::try_as, so a field is left unchanged if its value does not fit.
+     * @param section An @c ini_section or a @c frozen_ini::section
+     * @param out The struct to fill
+     * @return The missing, unknown and invalid keys
+     */
+    template<typename Struct, typename Section>
+    inline bind_result bind(const Section& section, Struct& out) {
+        constexpr auto const& table = binding<Struct>::fields;
+        constexpr std::size_t size = std::decay_t<decltype(table)>::size;
+
+        bind_result result;
+        std::array<bool, size> seen{};
+        for (auto&& entry : section) {
+            std::string_view const key = entry.first;
+            std::size_t const index = table.find(key);
+            if (index == size) {
+                result.unknown.emplace_back(key);
+                continue;
+            }
+
+            seen[index] = true;
+            if (!detail::bind_field(table, index, out, entry.second, std::make_index_sequence<size>())) result.invalid.emplace_back(key);
+        }
+
+        for (std::size_t i = 0; i < size; i++) {
+            if (!seen[i] && !table.is_optional(i)) result.missing.emplace_back(table.name(i));
+        }
+        return result;
+    }
+
+    /**
+     * @brief Creates a Struct from @p section, see @c bind(const Section&, Struct&). If any key is missing, unknown or
+     * invalid, an exception of type @c bind_exception listing all of them is thrown.
+     * @param section An @c ini_section or a @c frozen_ini::section
+     * @return The filled struct
+     */
+    template<typename Struct, typename Section>
+    inline Struct bind(const Section& section) {
+        Struct out{};
+        bind_result result = bind(section, out);
+        if (!result) throw bind_exception(section.get_name(), std::move(result));
+        return out;
+    }
+
+    inline bind_exception::bind_exception(std::string_view section, bind_result result) : std::runtime_error(format(section, result)),
+        m_result(std::make_shared<const bind_result>(std::move(result))) {}
+
+    inline std::string bind_exception::format(std::string_view section, const bind_result& result) {
+        std::string message = "bind [";
+        message.append(section).append("]");
+
+        bool first = true;
+        auto const list = [&](const char* what, const std::vector<std::string>& keys) {
+            if (keys.empty()) return;
+            message.append(first ? ": " : "; ").append(what);
+            first = false;
+            for (std::size_t i = 0; i < keys.size(); i++) message.append(i == 0 ? " " : ", ").append(keys[i]);
+        };
+
+        list("missing keys:", result.missing);
+        list("unknown keys:", result.unknown);
+        list("invalid values:", result.invalid);
+        return message;
+    }
+}
+
+#endif
@@ -0,0 +1,69 @@
+#ifndef INICPP_COUNTING_RESOURCE_H
+#define INICPP_COUNTING_RESOURCE_H 1
+
+#include "config.h"
+
+#include <atomic>
+#include <cstddef>
+#include <memory_resource>
+
+namespace inicpp {
+    /**
+     * @brief Memory resource that forwards to an upstream resource and counts what passes through it. An ini constructed
+     * with it reports the allocations of its sections and keys in @c parse_stats. The counters are atomic, so the
+     * resource may wrap a @c std::pmr::synchronized_pool_resource shared by several threads.
+     */
+    class counting_resource : public std::pmr::memory_resource {
+    public:
+        inline explicit counting_resource(std::pmr::memory_resource* upstream = std::pmr::get_default_resource()) noexcept : m_upstream(upstream) {}
+
+        counting_resource(const counting_resource&) = delete;
+        counting_resource& operator=(const counting_resource&) = delete;
+
+        inline std::pmr::memory_resource* upstream() const noexcept { return m_upstream; }
+
+        /**
+         * @brief Retrieves the number of allocations made so far
+         */
+        inline std::size_t allocations() const noexcept { return m_allocations.load(std::memory_order_relaxed); }
+
+        /**
+         * @brief Retrieves the number of deallocations made so far
+         */
+        inline std::size_t deallocations() const noexcept { return m_deallocations.load(std::memory_order_relaxed); }
+
+        /**
+         * @brief Retrieves the number of bytes allocated so far, including bytes that were freed again
+         */
+        inline std::size_t bytes_allocated() const noexcept { return m_bytes_allocated.load(std::memory_order_relaxed); }
+
+        /**
+         * @brief Retrieves the number of bytes currently allocated
+         */
+        inline std::size_t bytes_in_use() const noexcept { return m_bytes_in_use.load(std::memory_order_relaxed); }
+    private:
+        inline void* do_allocate(std::size_t bytes, std::size_t alignment) override {
+            void* const p = m_upstream->allocate(bytes, alignment);
+            m_allocations.fetch_add(1, std::memory_order_relaxed);
+            m_bytes_allocated.fetch_add(bytes, std::memory_order_relaxed);
+            m_bytes_in_use.fetch_add(bytes, std::memory_order_relaxed);
+            return p;
+        }
+
+        inline void do_deallocate(void* p, std::size_t bytes, std::size_t alignment) override {
+            m_upstream->deallocate(p, bytes, alignment);
+            m_deallocations.fetch_add(1, std::memory_order_relaxed);
+            m_bytes_in_use.fetch_sub(bytes, std::memory_order_relaxed);
+        }
+
+        inline bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override { return this == &other; }
+
+        std::pmr::memory_resource* m_upstream;
+        std::atomic<std::size_t> m_allocations{ 0 };
+        std::atomic<std::size_t> m_deallocations{ 0 };
+        std::atomic<std::size_t> m_bytes_allocated{ 0 };
+        std::atomic<std::size_t> m_bytes_in_use{ 0 };
+    };
+}
+
+#endif
@@ -0,0 +1,126 @@
+#ifndef INICPP_DETAIL_CONVERSION_CACHE_H
+#define INICPP_DETAIL_CONVERSION_CACHE_H 1
+
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+
+namespace inicpp::detail {
+    // Identifies the types whose conversions are cached, 0 for the others
+    template<typename T>
+    constexpr std::uint32_t conversion_tag() noexcept {
+        if constexpr (std::is_same_v<T, unsigned long long>) return 1;
+        else if constexpr (std::is_same_v<T, signed long long>) return 2;
+        else if constexpr (std::is_same_v<T, unsigned long>) return 3;
+        else if constexpr (std::is_same_v<T, signed long>) return 4;
+        else if constexpr (std::is_same_v<T, unsigned int>) return 5;
+        else if constexpr (std::is_same_v<T, signed int>) return 6;
+        else if constexpr (std::is_same_v<T, unsigned short>) return 7;
+        else if constexpr (std::is_same_v<T, signed short>) return 8;
+        else if constexpr (std::is_same_v<T, float>) return 9;
+        else if constexpr (std::is_same_v<T, double>) return 10;
+        else return 0;
+    }
+
+    /**
+     * @brief Remembers the result of the last successful numeric conversion of a value, so that converting it to the same
+     * type again is two loads and a compare. The slot is filled by const lookups, which may run on several threads at
+     * once: a converter claims the slot before writing it, and readers check that the slot was not claimed again while
+     * they read it. A reader that loses the race simply converts the text again.
+     *
+     * The cache makes every @c ini_value 16 bytes larger, 64 instead of 48 bytes on 64-bit targets with libstdc++.
+     *
+     * Clearing the slot is a modification of the value and must not race with lookups.
+     */
+    class conversion_cache {
+    public:
+        constexpr conversion_cache() noexcept = default;
+
+        inline conversion_cache(const conversion_cache& other) noexcept { copy(other); }
+
+        inline conversion_cache& operator=(const conversion_cache& other) noexcept {
+            if (this != &other) copy(other);
+            return *this;
+        }
+
+        /**
+         * @brief Whether conversions to T are cached: the integer types, float and double.
+         */
+        template<typename T>
+        static constexpr bool is_cached = conversion_tag<T>() != 0;
+
+        /**
+         * @brief Retrieves the cached conversion to T.
+         * @return True if @p out received the cached value, false if the last conversion was not to T
+         */
+        template<typename T>
+        inline bool load(T& out) const noexcept {
+            std::uint64_t bits;
+            if (!read(conversion_tag<T>(), bits)) return false;
+            if constexpr (std::is_floating_point_v<T>) std::memcpy(&out, &bits, sizeof(T));
+            else out = static_cast<T>(bits);
+            return true;
+        }
+
+        /**
+         * @brief Caches a conversion to T, unless another thread is caching a conversion of the same value right now.
+         */
+        template<typename T>
+        inline void store(T value) const noexcept {
+            std::uint64_t bits = 0;
+            if constexpr (std::is_floating_point_v<T>) std::memcpy(&bits, &value, sizeof(T));
+            else bits = static_cast<std::uint64_t>(value);
+            write(conversion_tag<T>(), bits);
+        }
+
+        /**
+         * @brief Forgets the cached conversion, after the text of the value has changed.
+         */
+        inline void clear() noexcept { m_state.store(next_generation(m_state.load(std::memory_order_relaxed)) | empty, std::memory_order_relaxed); }
+    private:
+        // the low byte of the state is the tag of the cached type, the rest a generation that every writer bumps
+        static constexpr std::uint32_t empty = 0;
+        static constexpr std::uint32_t busy = 0xff;
+        static constexpr std::uint32_t tag_mask = 0xff;
+
+        static constexpr std::uint32_t next_generation(std::uint32_t state) noexcept { return (state & ~tag_mask) + (tag_mask + 1); }
+
+        inline bool read(std::uint32_t tag, std::uint64_t& bits) const noexcept {
+            std::uint32_t const state = m_state.load(std::memory_order_acquire);
+            if ((state & tag_mask) != tag) return false;
+
+            // if the bits come from a later writer, its claim of the slot is visible to the second load of the state
+            bits = m_bits.load(std::memory_order_acquire);
+            return m_state.load(std::memory_order_relaxed) == state;
+        }
+
+        inline void write(std::uint32_t tag, std::uint64_t bits) const noexcept {
+            std::uint32_t state = m_state.load(std::memory_order_relaxed);
+            if ((state & tag_mask) == busy) return;
+
+            std::uint32_t const generation = next_generation(state);
+            if (!m_state.compare_exchange_strong(state, generation | busy, std::memory_order_relaxed)) return;
+
+            // the release store keeps the claim above ordered before the new bits, see read
+            m_bits.store(bits, std::memory_order_release);
+            m_state.store(generation | tag, std::memory_order_release);
+        }
+
+        inline void copy(const conversion_cache& other) noexcept {
+            std::uint32_t const tag = other.m_state.load(std::memory_order_relaxed) & tag_mask;
+            std::uint64_t bits;
+            if (tag != empty && tag != busy && other.read(tag, bits)) {
+                m_bits.store(bits, std::memory_order_relaxed);
+                m_state.store(next_generation(m_state.load(std::memory_order_relaxed)) | tag, std::memory_order_relaxed);
+            } else {
+                clear();
+            }
+        }
+
+        mutable std::atomic<std::uint64_t> m_bits{ 0 };
+        mutable std::atomic<std::uint32_t> m_state{ empty };
+    };
+}
+
+#endif
@@ -0,0 +1,148 @@
+#ifndef INICPP_DETAIL_CONVERT_H
+#define INICPP_DETAIL_CONVERT_H 1
+
+#include <charconv>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <type_traits>
+
+namespace inicpp::detail {
+    /**
+     * @brief Parses the number at the start of [first, last) with @c std::from_chars, which neither allocates nor consults
+     * the locale. Leading whitespace and a '+' sign are skipped first, as they were by the std::sto* functions.
+     * @param out Receives the number; left unchanged on failure
+     */
+    template<typename T>
+    inline std::from_chars_result parse_number(const char* first, const char* const last, T& out) noexcept {
+        for (; first != last && (*first == ' ' || (*first >= '\t' && *first <= '\r')); ++first);
+        if (last - first > 1 && *first == '+' && first[1] != '+' && first[1] != '-') ++first;
+
+        if constexpr (std::is_floating_point_v<T>) {
+            return std::from_chars(first, last, out, std::chars_format::general);
+        } else if constexpr (std::is_unsigned_v<T>) {
+            // std::sto* wrapped negative numbers around; they are reported as out of range instead, except for -0
+            if (first == last || *first != '-') return std::from_chars(first, last, out, 10);
+            T magnitude{};
+            auto result = std::from_chars(first + 1, last, magnitude, 10);
+            if (result.ec == std::errc() && magnitude != 0) result.ec = std::errc::result_out_of_range;
+            else if (result.ec == std::errc()) out = 0;
+            else if (result.ec == std::errc::invalid_argument) result.ptr = first;
+            return result;
+        } else {
+            return std::from_chars(first, last, out, 10);
+        }
+    }
+
+    /**
+     * @brief Parses a number with the error handling of the matching std::sto* function: an exception of type
+     * @c std::invalid_argument is thrown if no conversion could be performed and @c std::out_of_range if the result does
+     * not fit. Like std::sto*, the number may be followed by other characters.
+     * @param name Name reported by the exception
+     */
+    template<typename T>
+    inline T to_number(const char* name, const char* str, std::size_t length) {
+        T result{};
+        std::errc const error = parse_number(str, str + length, result).ec;
+        if (error == std::errc::result_out_of_range) throw std::out_of_range(name);
+        if (error != std::errc()) throw std::invalid_argument(name);
+        return result;
+    }
+
+    /**
+     * @brief Converts the text of a value to T. Shared by @c ini_value and @c frozen_ini so that both accept the same
+     * spellings and throw the same exceptions.
+     * @param str The text of the value, which must be followed by a NUL character if T is @c const @c char*
+     * @param length Length of the text, excluding the NUL character
+     */
+    template<typename T>
+    T convert(const char* str, std::size_t length);
+
+    template<>
+    inline const char* convert(const char* str, std::size_t) { return str; }
+
+    template<>
+    inline std::string_view convert(const char* str, std::size_t length) { return std::string_view(str, length); }
+
+    template<>
+    inline std::string convert(const char* str, std::size_t length) { return std::string(str, length); }
+
+    template<>
+    inline unsigned long long convert(const char* str, std::size_t length) { return to_number<unsigned long long>("stoull", str, length); }
+
+    template<>
+    inline signed long long convert(const char* str, std::size_t length) { return to_number<signed long long>("stoll", str, length); }
+
+    template<>
+    inline unsigned long convert(const char* str, std::size_t length) { return to_number<unsigned long>("stoul", str, length); }
+
+    template<>
+    inline signed long convert(const char* str, std::size_t length) { return to_number<signed long>("stol", str, length); }
+
+    template<>
+    inline unsigned int convert(const char* str, std::size_t length) { return to_number<unsigned int>("stoui", str, length); }
+
+    template<>
+    inline signed int convert(const char* str, std::size_t length) { return to_number<signed int>("stoi", str, length); }
+
+    template<>
+    inline unsigned short convert(const char* str, std::size_t length) { return to_number<unsigned short>("stous", str, length); }
+
+    template<>
+    inline signed short convert(const char* str, std::size_t length) { return to_number<signed short>("stos", str, length); }
+
+    template<>
+    inline char convert(const char* str, std::size_t length) {
+        if (length != 1)
+            throw std::length_error("ini_value::get_value()::length() != 1");
+        return str[0];
+    }
+
+    template<>
+    inline unsigned char convert(const char* str, std::size_t length) { return static_cast<unsigned char>(convert<char>(str, length)); }
+
+    template<>
+    inline signed char convert(const char* str, std::size_t length) { return static_cast<signed char>(convert<char>(str, length)); }
+
+    template<>
+    inline float convert(const char* str, std::size_t length) { return to_number<float>("stof", str, length); }
+
+    template<>
+    inline double convert(const char* str, std::size_t length) { return to_number<double>("stod", str, length); }
+
+    template<>
+    inline long double convert(const char* str, std::size_t length) { return to_number<long double>("stold", str, length); }
+
+    // Whether try_convert<T> cannot throw, which only copying into a std::string can
+    template<typename T>
+    inline constexpr bool is_nothrow_convertible = !std::is_same_v<T, std::string>;
+
+    /**
+     * @brief Converts the text of a value to T without throwing, for validating many values cheaply. Unlike @c convert,
+     * a number has to span the whole text.
+     * @param out Receives the converted value; left unchanged on failure
+     * @return @c std::errc() on success, @c std::errc::invalid_argument if the text is not a T and
+     * @c std::errc::result_out_of_range if the number does not fit into T
+     */
+    template<typename T>
+    inline std::errc try_convert(const char* str, std::size_t length, T& out) noexcept(is_nothrow_convertible<T>) {
+        if constexpr (std::is_same_v<T, char> || std::is_same_v<T, signed char> || std::is_same_v<T, unsigned char>) {
+            if (length != 1) return std::errc::invalid_argument;
+            out = static_cast<T>(str[0]);
+            return std::errc();
+        } else if constexpr (std::is_arithmetic_v<T>) {
+            T value{};
+            auto const result = parse_number(str, str + length, value);
+            if (result.ec != std::errc()) return result.ec;
+            if (result.ptr != str + length) return std::errc::invalid_argument;
+            out = value;
+            return std::errc();
+        } else {
+            out = convert<T>(str, length);
+            return std::errc();
+        }
+    }
+}
+
+#endif
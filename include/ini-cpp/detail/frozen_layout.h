@@ -0,0 +1,84 @@
+#ifndef INICPP_DETAIL_FROZEN_LAYOUT_H
+#define INICPP_DETAIL_FROZEN_LAYOUT_H 1
+
+#include <cstdint>
+
+namespace inicpp::detail {
+    /*
+     * A frozen_ini lives in a single blob:
+     *
+     *   frozen_header
+     *   frozen_section[section_count]     in file order
+     *   frozen_key[key_count]             grouped by section, in file order
+     *   perfect hash table of the sections
+     *   perfect hash table of the keys, one per section
+     *   string pool                       names and values, each followed by a NUL character
+     *
+     * All offsets are relative to the start of the blob, so the blob can be stored and loaded as is.
+     *
+     * A compiled file (ini::save_binary) is a frozen_file_header followed by the blob. Loading it maps the file and
+     * points a frozen_ini at the blob; there is nothing to relocate.
+     */
+
+    /**
+     * @brief Hash-and-displace perfect hash table. The low half of the hash of an entry picks its bucket, and the seed of that
+     * bucket is mixed into the hash to pick its slot. Each slot holds an entry index or @c empty.
+     * Keys get a small table per section, which keeps a lookup within a few cache lines.
+     */
+    struct frozen_table {
+        static constexpr std::uint32_t empty = ~std::uint32_t(0);
+
+        std::uint32_t bucket_count;
+        std::uint32_t seeds;        // offset of uint32_t[bucket_count]
+        std::uint32_t slot_count;
+        std::uint32_t slots;        // offset of uint32_t[slot_count]
+    };
+
+    struct frozen_header {
+        std::uint32_t size;         // size of the whole blob in bytes
+        std::uint32_t salt;         // seed of the name hashes
+        std::uint32_t section_count;
+        std::uint32_t key_count;
+        std::uint32_t sections;     // offset of frozen_section[section_count]
+        std::uint32_t keys;         // offset of frozen_key[key_count]
+        frozen_table section_table;
+        std::uint32_t strings;      // offset of the string pool
+    };
+
+    struct frozen_section {
+        std::uint32_t name;
+        std::uint32_t name_length;
+        std::uint32_t first_key;
+        std::uint32_t key_count;
+        frozen_table key_table;     // slots hold indices relative to first_key
+    };
+
+    struct frozen_key {
+        std::uint32_t name;
+        std::uint32_t name_length;
+        std::uint32_t value;
+        std::uint32_t value_length;
+    };
+
+    // Bumped whenever the layout of the blob or the hashes stored in it change
+    constexpr std::uint32_t frozen_format_version = 1;
+
+    // Fingerprint of the structures above. It reads differently on a machine of the other byte order, so files are only
+    // accepted where they can be used as is.
+    constexpr std::uint32_t frozen_layout_tag = (std::uint32_t(sizeof(frozen_header)) << 16) | (std::uint32_t(sizeof(frozen_section)) << 8)
+        | std::uint32_t(sizeof(frozen_key));
+
+    struct frozen_file_header {
+        char magic[8];              // "INICPPB" and a NUL character
+        std::uint32_t version;      // frozen_format_version
+        std::uint32_t layout;       // frozen_layout_tag
+        std::uint64_t source_hash;  // hash of the source text and parser settings, 0 if unknown
+        std::uint64_t size;         // size of the blob that follows
+        std::uint64_t checksum;     // hash of the blob
+        std::uint64_t header_checksum;  // hash of the fields above
+    };
+
+    static_assert(sizeof(frozen_file_header) % 8 == 0, "the blob that follows the header must stay aligned");
+}
+
+#endif
@@ -6,29 +6,61 @@
 
 #include <initializer_list>
 #include <algorithm>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <memory_resource>
+#include <string>
+#include <string_view>
+#include <tuple>
+#include <vector>
 
 namespace inicpp::detail {
     /**
-     * @brief ordered_map is an ordered container that contains key-value pairs with unique keys. Search, insertion,
-     * and removal of elements have average constant-time complexity. Internally, this uses std::unordered_map and std::list
-     * in order to provide (average) constant-time complexity.
+     * @brief Describes how keys of type K are looked up. String keys are looked up through the matching string view, so that
+     * lookups by string literal or view do not have to construct a temporary key. The hash of a string and of the equivalent
+     * view are guaranteed to be equal, so both can probe the same index.
+     * @tparam K Type of key objects.
+     */
+    template<typename K>
+    struct lookup_traits {
+        typedef const K& key_param;
+        typedef std::hash<K> hasher;
+        static constexpr bool heterogeneous = false;
+    };
+
+    template<typename CharT, typename Traits, typename Alloc>
+    struct lookup_traits<std::basic_string<CharT, Traits, Alloc>> {
+        typedef std::basic_string_view<CharT, Traits> key_param;
+        typedef std::hash<std::basic_string_view<CharT, Traits>> hasher;
+        static constexpr bool heterogeneous = true;
+    };
+
+    /**
+     * @brief ordered_map is an ordered container that contains key-value pairs with unique keys. Search, insertion at the end,
+     * and removal of elements have average constant-time complexity. Internally, the entries are kept in insertion order in one
+     * contiguous vector and located through an open-addressing index of slot numbers. Erased entries become tombstones that are
+     * compacted away once they make up a large part of the vector. Each key-value pair lives in its own node, so references to
+     * elements stay valid until the element is erased. All memory is allocated from the container's @c std::pmr::memory_resource.
      * @tparam K Type of key objects.
      * @tparam V Type of mapped objects.
      */
     template<typename K, typename V>
     class ordered_map {
     public:
-        typedef typename std::unordered_map<K, V>::key_type key_type;
-        typedef typename std::unordered_map<K, V>::mapped_type mapped_type;
-        typedef typename std::unordered_map<K, V>::value_type value_type;
-        typedef typename std::unordered_map<K, V>::size_type size_type;
-        typedef typename std::unordered_map<K, V>::difference_type difference_type;
-        typedef typename std::unordered_map<K, V>::hasher hasher;
-        typedef typename std::unordered_map<K, V>::key_equal key_equal;
-        typedef typename std::unordered_map<K, V>::reference reference;
-        typedef typename std::unordered_map<K, V>::const_reference const_reference;
-        typedef typename std::unordered_map<K, V>::pointer pointer;
-        typedef typename std::unordered_map<K, V>::const_pointer const_pointer;
+        typedef K key_type;
+        typedef V mapped_type;
+        typedef std::pair<const K, V> value_type;
+        typedef std::size_t size_type;
+        typedef std::ptrdiff_t difference_type;
+        typedef typename lookup_traits<K>::hasher hasher;
+        typedef std::equal_to<> key_equal;
+        typedef typename lookup_traits<K>::key_param lookup_key;
+        typedef value_type& reference;
+        typedef value_type const& const_reference;
+        typedef value_type* pointer;
+        typedef value_type const* const_pointer;
+        typedef std::pmr::polymorphic_allocator<value_type> allocator_type;
 
         typedef ordered_map_iterator<K, V> iterator;
         typedef ordered_map_iterator<K, V const> const_iterator;
@@ -37,6 +69,16 @@ namespace inicpp::detail {
         typedef detail::reverse_iterator<const_iterator> const_reverse_iterator;
     private:
         typedef ordered_map<K, V> ordered_map_type;
+        typedef std::allocator_traits<allocator_type> allocator_traits;
+
+        struct entry {
+            // null once the entry has been erased
+            value_type* value;
+            std::size_t hash;
+        };
+
+        // Index cells hold slot + 1, so that 0 marks an empty cell
+        typedef std::uint32_t index_cell;
     public:
         /**
          * @brief Default constructor. Constructs an empty container with a default-constructed allocator.
@@ -44,16 +86,44 @@ namespace inicpp::detail {
         ordered_map() = default;
 
         /**
-         * @brief Copy constructor. Constructs the container with the copy of the contents of other.
+         * @brief Constructs an empty container that allocates from the given allocator.
+         * @param alloc allocator to use for all memory allocations of this container
+         */
+        inline explicit ordered_map(const allocator_type& alloc) : m_entries(alloc), m_index(alloc) {}
+
+        /**
+         * @brief Copy constructor. Constructs the container with the copy of the contents of other, using the default memory resource.
          * @param other another container to be used as source to initialize the elements of the container with
          */
-        ordered_map(const ordered_map& other) = default;
+        inline ordered_map(const ordered_map& other) : ordered_map(other, allocator_type()) {}
+
+        /**
+         * @brief Allocator-extended copy constructor. Constructs the container with the copy of the contents of other.
+         * @param other another container to be used as source to initialize the elements of the container with
+         * @param alloc allocator to use for all memory allocations of this container
+         */
+        inline ordered_map(const ordered_map& other, const allocator_type& alloc) : ordered_map(alloc) {
+            reserve(other.size());
+            for (auto const& value : other) push_back(value);
+        }
 
         /**
          * @brief Move constructor. Constructs the container with the contents of other using move semantics.
          * @param other another container to be used as source to initialize the elements of the container with
          */
-        ordered_map(ordered_map&& other) = default;
+        inline ordered_map(ordered_map&& other) noexcept
+            : m_entries(std::move(other.m_entries)), m_index(std::move(other.m_index)),
+            m_size(std::exchange(other.m_size, 0)), m_index_used(std::exchange(other.m_index_used, 0)) {
+            other.m_entries.clear();
+            other.m_index.clear();
+        }
+
+        /**
+         * @brief Allocator-extended move constructor. If alloc compares unequal to the allocator of other, the elements are moved one by one.
+         * @param other another container to be used as source to initialize the elements of the container with
+         * @param alloc allocator to use for all memory allocations of this container
+         */
+        inline ordered_map(ordered_map&& other, const allocator_type& alloc) : ordered_map(alloc) { *this = std::move(other); }
 
         /**
          * @brief Constructs the container with the contents of the range [first, last). Sets max_load_factor() to 1.0.
@@ -63,7 +133,7 @@ namespace inicpp::detail {
          * @param last the range to copy the elements from
          */
         template< class InputIt >
-        inline ordered_map(InputIt first, InputIt last) {
+        inline ordered_map(InputIt first, InputIt last, const allocator_type& alloc = allocator_type()) : ordered_map(alloc) {
             for (; first != last; ++first) {
                 push_back(*first);
             }
@@ -74,67 +144,118 @@ namespace inicpp::detail {
          * If multiple elements in the range have keys that compare equivalent, the last one is kept.
          * @param init initializer list to initialize the elements of the container with
          */
-        inline ordered_map(std::initializer_list<value_type> init) : ordered_map(init.begin(), init.end()) { }
+        inline ordered_map(std::initializer_list<value_type> init, const allocator_type& alloc = allocator_type()) : ordered_map(init.begin(), init.end(), alloc) { }
 
         /**
-         * @brief Copy assignment operator. Replaces the contents with a copy of the contents of other.
+         * @brief Destroys all elements and releases their nodes.
+         */
+        inline ~ordered_map() { destroy_values(); }
+
+        /**
+         * @brief Copy assignment operator. Replaces the contents with a copy of the contents of other. The allocator is not replaced.
          * @param other another container to use as data source
          * @return @c *this
          */
-        ordered_map& operator=(const ordered_map& other) = default;
+        inline ordered_map& operator=(const ordered_map& other) {
+            if (this != &other) {
+                clear();
+                reserve(other.size());
+                for (auto const& value : other) push_back(value);
+            }
+            return *this;
+        }
 
         /**
          * @brief Move assignment operator. Replaces the contents with those of other using move semantics (i.e. the data in other is moved from other into this container).
+         * The allocator is not replaced; if it compares unequal to the allocator of other, the elements are moved one by one.
          * other is in a valid but unspecified state afterwards.
          * @param other another container to use as data source
          * @return *this
          */
-        ordered_map& operator=(ordered_map&& other) = default;
+        inline ordered_map& operator=(ordered_map&& other) {
+            if (this == &other) return *this;
+            clear();
+            if (get_allocator() == other.get_allocator()) {
+                // nodes are taken over as is, so references to the elements stay valid
+                m_entries = std::move(other.m_entries);
+                m_index = std::move(other.m_index);
+                m_size = std::exchange(other.m_size, 0);
+                m_index_used = std::exchange(other.m_index_used, 0);
+                other.m_entries.clear();
+                other.m_index.clear();
+            } else {
+                reserve(other.size());
+                for (auto& value : other) push_back(value_type(value.first, std::move(value.second)));
+                other.clear();
+            }
+            return *this;
+        }
+
+        /**
+         * @brief Returns the allocator associated with the container.
+         * @return The associated allocator.
+         */
+        inline allocator_type get_allocator() const noexcept { return m_entries.get_allocator(); }
 
         /**
          * @brief Checks if the container has no elements, i.e. whether begin() == end().
          * @return true if the container is empty, false otherwise
          */
-        inline bool empty() const noexcept { return m_map.empty(); }
+        inline bool empty() const noexcept { return m_size == 0; }
 
         /**
          * @brief Returns the number of elements in the container, i.e. std::distance(begin(), end()).
          * @return The number of elements in the container.
          */
-        inline size_type size() const noexcept { return m_map.size(); }
+        inline size_type size() const noexcept { return m_size; }
 
         /**
          * @brief Returns the maximum number of elements the container is able to hold due to system or library implementation limitations, i.e. std::distance(begin(), end()) for the largest container.
          * @return Maximum number of elements.
          */
-        inline size_type max_size() const noexcept { return std::min(m_order.max_size(), std::min(m_map.max_size(), m_lookup_map.max_size())); }
+        inline size_type max_size() const noexcept { return std::min<size_type>(m_entries.max_size(), std::numeric_limits<index_cell>::max() / 2); }
+
+        /**
+         * @brief Reserves space for at least the specified number of elements, so that inserting them at the end does not reallocate the entries or rebuild the index.
+         * @param count new capacity of the container
+         */
+        inline void reserve(size_type count) {
+            m_entries.reserve(count);
+            if (index_capacity_for(count) > m_index.size()) rebuild_index(count);
+        }
 
         /**
          * @brief Erases all elements from the container. After this call, size() returns zero.
          * Invalidates any references, pointers, or iterators referring to contained elements. May also invalidate past-the-end iterators.
          */
-        inline void clear() noexcept { m_order.clear(); m_map.clear(); m_lookup_map.clear(); }
+        inline void clear() noexcept {
+            destroy_values();
+            m_entries.clear();
+            std::fill(m_index.begin(), m_index.end(), index_cell(0));
+            m_size = 0;
+            m_index_used = 0;
+        }
 
         /**
-         * @brief Prepends the given element value to the beginning of the container. No iterators or references are invalidated.
+         * @brief Prepends the given element value to the beginning of the container. References are not invalidated; iterators are.
          * @param value the value of the element to prepend
          */
         inline void push_front(const value_type& value) { insert(cbegin(), value); }
 
         /**
-         * @brief Prepends the given element value to the beginning of the container. No iterators or references are invalidated.
+         * @brief Prepends the given element value to the beginning of the container. References are not invalidated; iterators are.
          * @param value the value of the element to prepend
          */
         inline void push_front(value_type&& value) { insert(cbegin(), std::move(value)); }
 
         /**
-         * @brief Appends the given element value to the end of the container. No iterators or references are invalidated.
+         * @brief Appends the given element value to the end of the container. No references or iterators to other elements are invalidated.
          * @param value the value of the element to append
          */
         inline void push_back(const value_type& value) { insert(cend(), value); }
 
         /**
-         * @brief Appends the given element value to the end of the container. No iterators or references are invalidated.
+         * @brief Appends the given element value to the end of the container. No references or iterators to other elements are invalidated.
          * @param value the value of the element to append
          */
         inline void push_back(value_type&& value) { insert(cend(), std::move(value)); }
@@ -143,74 +264,56 @@ namespace inicpp::detail {
          * @brief Removes the first element of the container. Calling pop_front on an empty container is a no-op.
          * References and iterators to the erased element are invalidated.
          */
-        inline void pop_front() { if (size() > 0) { erase(m_lookup_map[m_order.front()]); } }
+        inline void pop_front() { if (size() > 0) { erase(cbegin()); } }
 
         /**
          * @brief Removes the last element of the container. Calling pop_back on an empty container is a no-op.
          * References and iterators to the erased element are invalidated.
          */
-        inline void pop_back() { if (size() > 0) { erase(m_lookup_map[m_order.back()]); } }
+        inline void pop_back() { if (size() > 0) { erase(--cend()); } }
 
         /**
          * @brief Inserts element(s) into the container. If the container doesn't already contain an element with an equivalent key,
          * the element is inserted at the desired position. If the element already exists within the container, it is relocated and has its value reassigned.
+         * Inserting or relocating anywhere but the end is linear in the size of the container and invalidates iterators, but not references.
          * @param pos iterator before which the content will be inserted (pos may be the end() iterator)
          * @param value element value to insert
          * @return Returns an iterator to the inserted element
          */
-        iterator insert(const_iterator pos, const value_type& value) {
-            auto c = m_map.find(value.first);
-            if (c == m_map.end()) {
-                auto r = m_map.insert(value);
-                auto i = m_order.insert(pos.m_order_it, r.first.operator->());
-                m_lookup_map[r.first.operator->()] = i;
-                return iterator(i);
-            } else {
-                auto f = m_lookup_map.find(c.operator->());
-                typename std::list<value_type*>::const_iterator p_it = f->second;
-                (*p_it)->second = value.second;
-                auto i = m_order.insert(pos.m_order_it, (*p_it));
-                f->second = i;
-                m_order.erase(p_it);
-                return iterator(i);
-            }
-        }
+        inline iterator insert(const_iterator pos, const value_type& value) { return emplace_at(pos.m_slot, value); }
 
         /**
          * @brief Inserts element(s) into the container. If the container doesn't already contain an element with an equivalent key,
          * the element is inserted at the desired position. If the element already exists within the container, its is relocated and has its value reassigned.
+         * Inserting or relocating anywhere but the end is linear in the size of the container and invalidates iterators, but not references.
          * @param pos iterator before which the content will be inserted (pos may be the end() iterator)
          * @param value element value to insert
          * @return Returns an iterator to the inserted element
          */
-        iterator insert(const_iterator pos, value_type&& value) {
-            auto c = m_map.find(value.first);
-            if (c == m_map.end()) {
-                auto r = m_map.insert(std::move(value));
-                auto i = m_order.insert(pos.m_order_it, r.first.operator->());
-                m_lookup_map[r.first.operator->()] = i;
-                return iterator(i);
-            } else {
-                auto f = m_lookup_map.find(c.operator->());
-                typename std::list<value_type*>::const_iterator p_it = f->second;
-                (*p_it)->second = std::move(value.second);
-                auto i = m_order.insert(pos.m_order_it, (*p_it));
-                f->second = i;
-                m_order.erase(p_it);
-                return iterator(i);
-            }
-        }
+        inline iterator insert(const_iterator pos, value_type&& value) { return emplace_at(pos.m_slot, std::move(value)); }
 
         /**
-         * @brief Erases the specified elements from the container.
+         * @brief Erases the specified elements from the container. Iterators may be invalidated if the erase triggers a compaction.
          * @param pos iterator to the element to remove
          * @return Iterator following the last removed element.
          */
-        inline iterator erase(const_iterator pos) {
-            m_map.erase(pos->first);
-            m_lookup_map.erase(*pos.m_order_it);
-            auto i = m_order.erase(pos.m_order_it);
-            return iterator(i);
+        iterator erase(const_iterator pos) {
+            entry& e = m_entries[pos.m_slot];
+            destroy_value(e.value);
+            e.value = nullptr;
+            m_size--;
+
+            std::size_t next = pos.m_slot;
+            for (++next; next < m_entries.size() && !m_entries[next].value; ++next);
+
+            // compact once at least half of the slots are tombstones
+            std::size_t const tombstones = m_entries.size() - m_size;
+            if (tombstones >= 16 && tombstones >= m_size) {
+                std::size_t const live_before = next - (std::count_if(m_entries.begin(), m_entries.begin() + next, [](entry const& e) { return !e.value; }));
+                compact();
+                return iterator(this, live_before);
+            }
+            return iterator(this, next);
         }
 
         /**
@@ -225,10 +328,10 @@ namespace inicpp::detail {
          * @param key key value of the elements to remove
          * @return Number of elements removed (0 or 1).
          */
-        inline size_type erase(const key_type& key) {
-            auto f = m_map.find(key);
-            if (f == m_map.end()) return 0;
-            erase(const_iterator(m_lookup_map[f.operator->()]));
+        inline size_type erase(lookup_key key) {
+            std::size_t const slot = find_slot(key, hasher()(key));
+            if (slot == npos) return 0;
+            erase(const_iterator(this, slot));
             return 1;
         }
 
@@ -237,13 +340,19 @@ namespace inicpp::detail {
          * @param key key value of the elements to remove
          * @return Number of elements removed (0 or 1).
          */
-        inline size_type remove(const key_type& key) { return erase(key); }
+        inline size_type remove(lookup_key key) { return erase(key); }
 
         /**
-         * @brief Exchanges the contents of the container with those of other. Does not invoke any move, copy, or swap operations on individual elements. All iterators and references remain valid. The end() iterator is invalidated.
+         * @brief Exchanges the contents of the container with those of other. Does not invoke any move, copy, or swap operations on individual elements. References remain valid. Iterators are invalidated.
+         * The behavior is undefined if the allocators of both containers compare unequal.
          * @param other container to exchange the contents with
          */
-        inline void swap(ordered_map& other) noexcept(noexcept(std::unordered_map<K, V>::swap)) { m_order.swap(other.m_order); m_map.swap(other.m_map); m_lookup_map.swap(other.m_lookup_map); }
+        inline void swap(ordered_map& other) noexcept {
+            m_entries.swap(other.m_entries);
+            m_index.swap(other.m_index);
+            std::swap(m_size, other.m_size);
+            std::swap(m_index_used, other.m_index_used);
+        }
 
         /**
          * @brief Sorts the elements in ascending order. The order of equal elements is preserved. The first version uses operator< to compare the elements,
@@ -258,23 +367,29 @@ namespace inicpp::detail {
          * @param comp comparison function object (i.e. an object that satisfies the requirements of Compare) which returns ​true if the first argument is less than (i.e. is ordered before) the second.
          */
         template<class Compare>
-        inline void sort(Compare comp) { m_order.sort([&comp](value_type* a, value_type* b) { return comp(*a, *b); }); }
+        inline void sort(Compare comp) {
+            compact();
+            std::stable_sort(m_entries.begin(), m_entries.end(), [&comp](entry const& a, entry const& b) { return comp(*a.value, *b.value); });
+            rebuild_index(m_size);
+        }
 
         /**
-         * @brief Reverses the order of the elements in the container. No references or iterators become invalidated.
+         * @brief Reverses the order of the elements in the container. No references become invalidated.
          */
-        inline void reverse() noexcept { m_order.reverse(); }
+        inline void reverse() {
+            compact();
+            std::reverse(m_entries.begin(), m_entries.end());
+            rebuild_index(m_size);
+        }
 
         /**
          * @brief Finds an element with key equivalent to key. This function has constant complexity on average, worst case linear in the size of the container.
          * @param key key value of the element to search for
          * @return Iterator to an element with key equivalent to key. If no such element is found, past-the-end (see end()) iterator is returned.
          */
-        inline iterator find(const key_type& key) {
-            auto look = m_map.find(key);
-            if (look == m_map.end()) { return end(); }
-            auto f = m_lookup_map.find(look.operator->());
-            return iterator(f->second);
+        inline iterator find(lookup_key key) {
+            std::size_t const slot = find_slot(key, hasher()(key));
+            return slot == npos ? end() : iterator(this, slot);
         }
 
         /**
@@ -282,11 +397,9 @@ namespace inicpp::detail {
          * @param key key value of the element to search for
          * @return Iterator to an element with key equivalent to key. If no such element is found, past-the-end (see end()) iterator is returned.
          */
-        inline const_iterator find(const key_type& key) const {
-            auto look = m_map.find(key);
-            if (look == m_map.end()) { return end(); }
-            auto f = m_lookup_map.find(look.operator->());
-            return const_iterator(f->second);
+        inline const_iterator find(lookup_key key) const {
+            std::size_t const slot = find_slot(key, hasher()(key));
+            return slot == npos ? end() : const_iterator(this, slot);
         }
 
         /**
@@ -294,9 +407,9 @@ namespace inicpp::detail {
          * @param key the key of the element to find
          * @return Reference to the mapped value of the requested element.
          */
-        inline mapped_type& at(const key_type& key) {
-            auto f = m_map.find(key);
-            if (f != m_map.end()) return f->second;
+        inline mapped_type& at(lookup_key key) {
+            std::size_t const slot = find_slot(key, hasher()(key));
+            if (slot != npos) return m_entries[slot].value->second;
             throw std::out_of_range("ordered_map::at");
         }
 
@@ -305,9 +418,9 @@ namespace inicpp::detail {
          * @param key the key of the element to find
          * @return Reference to the mapped value of the requested element.
          */
-        inline mapped_type const& at(const key_type& key) const {
-            auto f = m_map.find(key);
-            if (f != m_map.cend()) return f->second;
+        inline mapped_type const& at(lookup_key key) const {
+            std::size_t const slot = find_slot(key, hasher()(key));
+            if (slot != npos) return m_entries[slot].value->second;
             throw std::out_of_range("ordered_map::at");
         }
 
@@ -317,10 +430,10 @@ namespace inicpp::detail {
          * @return Reference to the mapped value of the new element if no element with key key existed. Otherwise a reference to the mapped value of the existing element whose key is equivalent to key.
          */
         inline mapped_type& operator[](const key_type& key) {
-            auto f = m_map.find(key);
-            if (f != m_map.end()) return f->second;
-            push_back(value_type(key, mapped_type()));
-            return back().second;
+            std::size_t const hash = hasher()(key);
+            std::size_t const slot = find_slot(key, hash);
+            if (slot != npos) return m_entries[slot].value->second;
+            return append(hash, key, mapped_type())->second;
         }
 
         /**
@@ -329,10 +442,24 @@ namespace inicpp::detail {
          * @return Reference to the mapped value of the new element if no element with key key existed. Otherwise a reference to the mapped value of the existing element whose key is equivalent to key.
          */
         inline mapped_type& operator[](key_type&& key) {
-            auto f = m_map.find(key);
-            if (f != m_map.end()) return f->second;
-            push_back(value_type(std::move(key), mapped_type()));
-            return back().second;
+            std::size_t const hash = hasher()(key);
+            std::size_t const slot = find_slot(key, hash);
+            if (slot != npos) return m_entries[slot].value->second;
+            return append(hash, std::move(key), mapped_type())->second;
+        }
+
+        /**
+         * @brief Returns a reference to the value that is mapped to a key equivalent to key, performing an insertion if such key does not already exist.
+         * Only available for string keys; the key is only copied into a new string if it has to be inserted.
+         * @param key the key of the element to find
+         * @return Reference to the mapped value of the new element if no element with key key existed. Otherwise a reference to the mapped value of the existing element whose key is equivalent to key.
+         */
+        template<bool Heterogeneous = lookup_traits<K>::heterogeneous, typename = std::enable_if_t<Heterogeneous>>
+        inline mapped_type& operator[](lookup_key key) {
+            std::size_t const hash = hasher()(key);
+            std::size_t const slot = find_slot(key, hash);
+            if (slot != npos) return m_entries[slot].value->second;
+            return append(hash, std::piecewise_construct, std::forward_as_tuple(key), std::forward_as_tuple())->second;
         }
 
         /**
@@ -340,77 +467,77 @@ namespace inicpp::detail {
          * @param key the key of the element to find
          * @return A reference to the mapped value of the existing element whose key is equivalent to key.
          */
-        inline mapped_type const& operator[](const key_type& key) const { return at(key); }
+        inline mapped_type const& operator[](lookup_key key) const { return at(key); }
 
         /**
          * @brief Checks if there is an element with key equivalent to key in the container.
          * @param key key value of the element to search for
          * @return true if there is such an element, otherwise false.
          */
-        inline bool contains(const key_type& key) const { return m_map.find(key) != m_map.end(); }
+        inline bool contains(lookup_key key) const { return find_slot(key, hasher()(key)) != npos; }
 
         /**
          * @brief Returns a reference to the last element in the container. Calling back on an empty container causes undefined behavior.
          * @return Reference to the last element.
          */
-        inline value_type& back() noexcept { return *m_order.back(); }
+        inline value_type& back() noexcept { return *--end(); }
 
         /**
          * @brief Returns a reference to the last element in the container. Calling back on an empty container causes undefined behavior.
          * @return Reference to the last element.
          */
-        inline value_type const& back() const noexcept { return *m_order.back(); }
+        inline value_type const& back() const noexcept { return *--end(); }
 
         /**
          * @brief Returns a reference to the first element in the container. Calling front on an empty container causes undefined behavior.
          * @return Reference to the first element
          */
-        inline value_type& front() noexcept { return *m_order.front(); }
+        inline value_type& front() noexcept { return *begin(); }
 
         /**
          * @brief Returns a reference to the first element in the container. Calling front on an empty container causes undefined behavior.
          * @return Reference to the first element
          */
-        inline value_type const& front() const noexcept { return *m_order.front(); }
+        inline value_type const& front() const noexcept { return *begin(); }
 
         /**
          * @brief Returns an iterator to the first element of the unordered_map. If the unordered_map is empty, the returned iterator will be equal to end().
          * @return Iterator to the first element.
          */
-        inline iterator begin() noexcept { return iterator(m_order.begin()); }
+        inline iterator begin() noexcept { return iterator(this, first_slot()); }
 
         /**
          * @brief Returns an iterator to the first element of the unordered_map. If the unordered_map is empty, the returned iterator will be equal to end().
          * @return Iterator to the first element.
          */
-        inline const_iterator begin() const noexcept { return const_iterator(m_order.begin()); }
+        inline const_iterator begin() const noexcept { return const_iterator(this, first_slot()); }
 
         /**
          * @brief Returns an iterator to the first element of the unordered_map. If the unordered_map is empty, the returned iterator will be equal to end().
          * @return Iterator to the first element.
          */
-        inline const_iterator cbegin() const noexcept { return const_iterator(m_order.cbegin()); }
+        inline const_iterator cbegin() const noexcept { return const_iterator(this, first_slot()); }
 
         /**
          * @brief Returns an iterator to the element following the last element of the unordered_map.
          * This element acts as a placeholder; attempting to access it results in undefined behavior.
          * @return Iterator to the element following the last element.
          */
-        inline iterator end() noexcept { return iterator(m_order.end()); }
+        inline iterator end() noexcept { return iterator(this, m_entries.size()); }
 
         /**
          * @brief Returns an iterator to the element following the last element of the unordered_map.
          * This element acts as a placeholder; attempting to access it results in undefined behavior.
          * @return Iterator to the element following the last element.
          */
-        inline const_iterator end() const noexcept { return const_iterator(m_order.end()); }
+        inline const_iterator end() const noexcept { return const_iterator(this, m_entries.size()); }
 
         /**
          * @brief Returns an iterator to the element following the last element of the unordered_map.
          * This element acts as a placeholder; attempting to access it results in undefined behavior.
          * @return Iterator to the element following the last element.
          */
-        inline const_iterator cend() const noexcept { return const_iterator(m_order.cend()); }
+        inline const_iterator cend() const noexcept { return const_iterator(this, m_entries.size()); }
 
         /**
          * @brief Returns a reverse iterator to the first element of the reversed ordered_map. It corresponds to the last element of the non-reversed ordered_map.
@@ -457,11 +584,150 @@ namespace inicpp::detail {
          */
         inline const_reverse_iterator rcend() const noexcept { return const_reverse_iterator(cbegin()); }
     private:
-        std::list<value_type*> m_order;
-        std::unordered_map<K, V> m_map;
-        std::unordered_map<value_type const*, typename std::list<value_type*>::const_iterator> m_lookup_map;
+        static constexpr std::size_t npos = std::size_t(-1);
+
+        // The index is kept at most half full so that probe sequences stay short
+        static inline std::size_t index_capacity_for(std::size_t count) noexcept {
+            std::size_t capacity = 16;
+            while (capacity < count * 2) capacity *= 2;
+            return capacity;
+        }
+
+        inline std::size_t first_slot() const noexcept {
+            std::size_t slot = 0;
+            for (; slot < m_entries.size() && !m_entries[slot].value; ++slot);
+            return slot;
+        }
+
+        std::size_t find_slot(lookup_key key, std::size_t hash) const {
+            if (m_index.empty()) return npos;
+
+            std::size_t const mask = m_index.size() - 1;
+            for (std::size_t i = hash & mask;; i = (i + 1) & mask) {
+                index_cell const cell = m_index[i];
+                if (cell == 0) return npos;
+
+                entry const& e = m_entries[cell - 1];
+                if (e.value && e.hash == hash && key_equal()(e.value->first, key)) return cell - 1;
+            }
+        }
+
+        inline void index_insert(std::size_t hash, std::size_t slot) noexcept {
+            std::size_t const mask = m_index.size() - 1;
+            std::size_t i = hash & mask;
+            for (; m_index[i] != 0; i = (i + 1) & mask);
+            m_index[i] = static_cast<index_cell>(slot + 1);
+            m_index_used++;
+        }
+
+        // Rebuilds the index from the live entries, sized for at least `count` elements
+        void rebuild_index(std::size_t count) {
+            std::size_t const capacity = index_capacity_for(std::max(count, m_size));
+            if (m_index.size() != capacity) m_index.assign(capacity, index_cell(0));
+            else std::fill(m_index.begin(), m_index.end(), index_cell(0));
+
+            m_index_used = 0;
+            for (std::size_t slot = 0; slot < m_entries.size(); slot++) {
+                if (m_entries[slot].value) index_insert(m_entries[slot].hash, slot);
+            }
+        }
+
+        // Removes all tombstones and renumbers the slots
+        void compact() {
+            if (m_size == m_entries.size()) return;
+            m_entries.erase(std::remove_if(m_entries.begin(), m_entries.end(), [](entry const& e) { return !e.value; }), m_entries.end());
+            rebuild_index(m_size);
+        }
+
+        template<typename... Args>
+        value_type* create_value(Args&&... args) {
+            allocator_type alloc = get_allocator();
+            value_type* value = allocator_traits::allocate(alloc, 1);
+            try {
+                allocator_traits::construct(alloc, value, std::forward<Args>(args)...);
+            } catch (...) {
+                allocator_traits::deallocate(alloc, value, 1);
+                throw;
+            }
+            return value;
+        }
+
+        inline void destroy_value(value_type* value) noexcept {
+            allocator_type alloc = get_allocator();
+            allocator_traits::destroy(alloc, value);
+            allocator_traits::deallocate(alloc, value, 1);
+        }
+
+        inline void destroy_values() noexcept {
+            for (entry& e : m_entries) {
+                if (e.value) destroy_value(e.value);
+                e.value = nullptr;
+            }
+        }
+
+        // Appends a new element whose key is known not to exist yet
+        template<typename... Args>
+        value_type* append(std::size_t hash, Args&&... args) {
+            if ((m_index_used + 1) * 2 > m_index.size()) rebuild_index(m_size + 1);
+
+            value_type* value = create_value(std::forward<Args>(args)...);
+            try {
+                m_entries.push_back({ value, hash });
+            } catch (...) {
+                destroy_value(value);
+                throw;
+            }
+
+            index_insert(hash, m_entries.size() - 1);
+            m_size++;
+            return value;
+        }
+
+        template<typename Value>
+        iterator emplace_at(std::size_t pos, Value&& value) {
+            std::size_t const hash = hasher()(value.first);
+            std::size_t slot = find_slot(value.first, hash);
+
+            if (slot == npos) {
+                if (pos == m_entries.size()) {
+                    append(hash, std::forward<Value>(value));
+                    return iterator(this, m_entries.size() - 1);
+                }
+
+                value_type* created = create_value(std::forward<Value>(value));
+                try {
+                    m_entries.insert(m_entries.begin() + pos, entry{ created, hash });
+                } catch (...) {
+                    destroy_value(created);
+                    throw;
+                }
+                m_size++;
+                rebuild_index(m_size);
+                return iterator(this, pos);
+            }
+
+            m_entries[slot].value->second = std::forward<Value>(value).second;
+
+            // relocate the existing entry to just before pos
+            if (pos == slot || pos == slot + 1) return iterator(this, slot);
+            if (pos > slot) {
+                std::rotate(m_entries.begin() + slot, m_entries.begin() + slot + 1, m_entries.begin() + pos);
+                slot = pos - 1;
+            } else {
+                std::rotate(m_entries.begin() + pos, m_entries.begin() + slot, m_entries.begin() + slot + 1);
+                slot = pos;
+            }
+            rebuild_index(m_size);
+            return iterator(this, slot);
+        }
+
+        std::vector<entry, std::pmr::polymorphic_allocator<entry>> m_entries;
+        std::vector<index_cell, std::pmr::polymorphic_allocator<index_cell>> m_index;
+        std::size_t m_size = 0;
+        std::size_t m_index_used = 0;
 
         friend struct ordered_map_iterator<K, V>;
+        friend struct ordered_map_iterator<K, V const>;
     };
 }
 #endif
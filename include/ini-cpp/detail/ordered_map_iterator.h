@@ -1,8 +1,7 @@
 #ifndef INICPP_ORDERED_MAP_ITERATOR_H
 #define INICPP_ORDERED_MAP_ITERATOR_H 1
 
-#include <unordered_map>
-#include <list>
+#include <cstddef>
 #include <type_traits>
 #include <utility>
 #include <functional>
@@ -15,14 +14,8 @@ namespace inicpp::detail {
     template<typename K, typename V>
     struct ordered_map_iterator {
     private:
-        typedef std::unordered_map<K, std::remove_const_t<std::remove_reference_t<V>>> base_unordered_map_type;
-        typedef std::conditional_t<std::is_const_v<std::remove_reference_t<V>>, base_unordered_map_type, base_unordered_map_type const>
-            unordered_map_type;
-
         typedef ordered_map_iterator<K, V> ordered_map_iterator_type;
         typedef ordered_map<K, std::remove_const_t<std::remove_reference_t<V>>> base_ordered_map_type;
-
-        typedef typename std::list<typename base_ordered_map_type::value_type*>::const_iterator iterator_type;
     public:
         typedef std::conditional_t<std::is_const_v<std::remove_reference_t<V>>, base_ordered_map_type const, base_ordered_map_type> ordered_map_type;
         typedef std::conditional_t<std::is_const_v<std::remove_reference_t<V>>, typename ordered_map_type::value_type const, typename ordered_map_type::value_type> value_type;
@@ -31,14 +24,14 @@ namespace inicpp::detail {
     public:
         template<typename K1, typename = std::enable_if_t<std::is_const_v<std::remove_reference_t<V>> && std::is_same_v<K1, K>>>
         inline ordered_map_iterator(const ordered_map_iterator<K1, std::remove_const_t<std::remove_reference_t<V>>>& other) noexcept
-            : m_order_it(other.m_order_it) {}
+            : m_map(other.m_map), m_slot(other.m_slot) {}
 
         template<typename K1, typename = std::enable_if_t<std::is_const_v<std::remove_reference_t<V>> && std::is_same_v<K1, K>>>
         inline ordered_map_iterator(ordered_map_iterator<K1, std::remove_const_t<std::remove_reference_t<V>>>&& other) noexcept
-            : m_order_it(std::move(other.m_order_it)) {}
+            : m_map(other.m_map), m_slot(other.m_slot) {}
 
-        inline ordered_map_iterator(iterator_type it) noexcept
-            : m_order_it(it) {}
+        inline ordered_map_iterator(ordered_map_type* map, std::size_t slot) noexcept
+            : m_map(map), m_slot(slot) {}
 
         ordered_map_iterator(const ordered_map_iterator&) noexcept = default;
         ordered_map_iterator(ordered_map_iterator&&) noexcept = default;
@@ -46,27 +39,38 @@ namespace inicpp::detail {
         constexpr ordered_map_iterator& operator=(const ordered_map_iterator&) noexcept = default;
         constexpr ordered_map_iterator& operator=(ordered_map_iterator&&) noexcept = default;
 
-        inline reference_type operator*() const { return **m_order_it; }
-        inline pointer_type operator->() const { return *m_order_it; }
+        inline reference_type operator*() const { return *m_map->m_entries[m_slot].value; }
+        inline pointer_type operator->() const { return m_map->m_entries[m_slot].value; }
+
+        // erased entries are left behind as tombstones until the next compaction, so both directions skip them
+        inline ordered_map_iterator_type& operator++() noexcept {
+            auto const size = m_map->m_entries.size();
+            for (++m_slot; m_slot < size && !m_map->m_entries[m_slot].value; ++m_slot);
+            return *this;
+        }
 
-        inline ordered_map_iterator_type& operator++() noexcept { ++m_order_it; return *this; }
         inline ordered_map_iterator_type operator++(int) noexcept {
             auto ret = *this;
             ++*this;
             return ret;
         }
 
-        inline ordered_map_iterator_type& operator--() noexcept { --m_order_it; return *this; }
+        inline ordered_map_iterator_type& operator--() noexcept {
+            while (m_slot > 0 && !m_map->m_entries[--m_slot].value);
+            return *this;
+        }
+
         inline ordered_map_iterator_type operator--(int) noexcept {
             auto ret = *this;
             --*this;
             return ret;
         }
 
-        inline bool operator==(const ordered_map_iterator_type& other) const noexcept { return m_order_it == other.m_order_it; }
+        inline bool operator==(const ordered_map_iterator_type& other) const noexcept { return m_slot == other.m_slot && m_map == other.m_map; }
         inline bool operator!=(const ordered_map_iterator_type& other) const noexcept { return !operator==(other); }
     private:
-        iterator_type m_order_it;
+        ordered_map_type* m_map;
+        std::size_t m_slot;
 
         friend class ordered_map<K, std::remove_const_t<std::remove_reference_t<V>>>;
 
@@ -75,4 +79,4 @@ namespace inicpp::detail {
     };
 }
 
-#endif
\ No newline at end of file
+#endif
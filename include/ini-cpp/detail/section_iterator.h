@@ -3,6 +3,7 @@
 
 #include <type_traits>
 #include <list>
+#include <memory_resource>
 
 namespace inicpp {
     class ini;
@@ -14,7 +15,7 @@ namespace inicpp {
             typedef value_type& reference_type;
             typedef value_type* pointer_type;
         private:
-            typedef std::list<std::remove_const_t<value_type>> impl_base_list;
+            typedef std::pmr::list<std::remove_const_t<value_type>> impl_base_list;
             typedef std::conditional_t<std::is_const_v<value_type>, impl_base_list const, impl_base_list> impl_list;
             typedef std::conditional_t<std::is_const_v<value_type>, typename impl_list::const_iterator, typename impl_list::iterator> impl_iterator;
 
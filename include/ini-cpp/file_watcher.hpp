@@ -0,0 +1,159 @@
+#ifndef INICPP_FILE_WATCHER_H
+#define INICPP_FILE_WATCHER_H 1
+
+#include "config.h"
+#include "ini.hpp"
+#include "shared_config.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace inicpp {
+    /**
+     * @brief Tuning knobs of a @c file_watcher.
+     */
+    struct watch_options {
+        // How long the file has to stay quiet after a change before it is read, so that a burst of writes causes one reload
+        std::chrono::milliseconds debounce{ 100 };
+
+        // How often the file is checked when change notifications are not available
+        std::chrono::milliseconds poll_interval{ 1000 };
+
+        // Checks the file periodically even where change notifications are available
+        bool force_polling = false;
+    };
+
+    /**
+     * @brief Keeps the configuration of a file up to date. The file is watched with inotify on Linux and polled elsewhere;
+     * after a burst of changes has settled, the file is only parsed again if its size or content hash differ from the
+     * last version that was read. Every new version is published through a @c shared_config and handed to subscribers.
+     * The file is read into a buffer rather than mapped, so a writer that truncates it in place cannot crash the reader.
+     *
+     * Subscribers and the error handler are called on the watcher thread, or on the thread that calls @c check. Subscribers
+     * are called for one version at a time and always in the order the versions were published; a version that was
+     * overtaken by a newer one before its notification started is skipped. A version that fails to parse is reported to
+     * the error handler and the previous version stays published.
+     */
+    class file_watcher {
+    public:
+        typedef std::function<void(const shared_config::snapshot&)> callback;
+        typedef std::function<void(std::exception_ptr)> error_handler;
+        typedef std::size_t subscription;
+    public:
+        /**
+         * @brief Reads the file at @p path and starts watching it. If the initial read fails, the exception is propagated.
+         * @param path Path of the file to watch
+         * @param options Debounce and polling intervals
+         */
+        INICPP explicit file_watcher(std::string path, watch_options options = watch_options());
+
+        /**
+         * @brief Reads the file at @p path into @p prototype and starts watching it. The comment handles and delimiter of
+         * @p prototype are used for every later read as well. If the initial read fails, the exception is propagated.
+         * @param path Path of the file to watch
+         * @param prototype Empty ini carrying the parser settings
+         * @param options Debounce and polling intervals
+         */
+        INICPP file_watcher(std::string path, ini prototype, watch_options options = watch_options());
+
+        file_watcher(const file_watcher&) = delete;
+        file_watcher& operator=(const file_watcher&) = delete;
+
+        /**
+         * @brief Stops watching. Waits for a reload that is in progress to finish.
+         */
+        INICPP ~file_watcher();
+
+        /**
+         * @brief Retrieves the published configuration, for readers that pin snapshots themselves.
+         */
+        inline const shared_config& config() const noexcept { return m_config; }
+
+        /**
+         * @brief Pins the current configuration.
+         */
+        inline shared_config::snapshot load() const noexcept { return m_config.load(); }
+
+        /**
+         * @brief Registers a function that is called with every new version of the configuration.
+         * @return Handle to pass to @c unsubscribe
+         */
+        INICPP subscription subscribe(callback f);
+
+        /**
+         * @brief Removes a subscriber. The subscriber may still be running when this returns if it is called from another thread.
+         */
+        INICPP void unsubscribe(subscription id);
+
+        /**
+         * @brief Sets the function that is told about files that could not be read or parsed.
+         */
+        INICPP void set_error_handler(error_handler f);
+
+        /**
+         * @brief Checks the file right away, without waiting for a notification. Must not be called from a subscriber.
+         * @return True if a new version was published, false if the content did not change or could not be read
+         */
+        INICPP bool check();
+
+        /**
+         * @brief Retrieves the number of times the file has actually been parsed, including the initial read.
+         */
+        inline std::uint64_t parse_count() const noexcept { return m_parse_count.load(std::memory_order_relaxed); }
+    private:
+        void run_inotify();
+        void open_notifications();
+        void close_notifications() noexcept;
+        void run_polling();
+        void report(std::exception_ptr error);
+
+        // Reads the whole file into m_text
+        void read_text();
+
+        // Settles until no change has been seen for the debounce interval, then checks the file
+        void settle_and_check();
+
+        std::string m_path;
+        watch_options m_options;
+
+        shared_config m_config;
+
+        // size and content hash of the last version that was parsed, the number of versions published by check and the
+        // buffer the file is read into, guarded by m_check_mutex
+        std::mutex m_check_mutex;
+        std::string m_text;
+        std::size_t m_size = 0;
+        std::uint64_t m_hash = 0;
+        std::uint64_t m_version = 0;
+        std::atomic<std::uint64_t> m_parse_count{ 0 };
+
+        // the last version handed to subscribers, guarded by m_notify_mutex
+        std::mutex m_notify_mutex;
+        std::uint64_t m_notified_version = 0;
+
+        std::mutex m_subscriber_mutex;
+        std::vector<std::pair<subscription, callback>> m_subscribers;
+        subscription m_next_subscription = 0;
+        error_handler m_error_handler;
+
+        std::mutex m_stop_mutex;
+        std::condition_variable m_stop_signal;
+        bool m_stopping = false;
+        int m_wake_fd = -1;
+        int m_notify_fd = -1;
+
+        std::thread m_thread;
+    };
+}
+
+#endif
@@ -0,0 +1,279 @@
+#ifndef INICPP_FROZEN_INI_H
+#define INICPP_FROZEN_INI_H 1
+
+#include "config.h"
+#include "detail/convert.h"
+#include "detail/frozen_layout.h"
+#include "parser.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <utility>
+
+namespace inicpp {
+    class ini;
+
+    /**
+     * @brief Immutable snapshot of an @c ini, created by @c ini::freeze(). All names and values are stored in a single
+     * string pool, and sections and keys are found through perfect hash tables, so a lookup is one hash and one compare.
+     * A frozen_ini is never modified after construction and may be read from any number of threads without locking.
+     * Copies share the same storage. Sections and values are views into it and remain valid while any copy is alive.
+     */
+    class frozen_ini {
+    public:
+        class value;
+        class section;
+
+        template<typename T, typename Entry>
+        class iterator;
+
+        typedef iterator<section, detail::frozen_section> const_iterator;
+    public:
+        frozen_ini() noexcept = default;
+
+        /**
+         * @brief Maps a compiled file written by @c save_binary. The snapshot reads straight from the mapping, so loading
+         * costs a checksum and a bounds check of the file, and no parsing or copying. The mapping stays alive as long as any copy of the
+         * snapshot; replacing the file with @c save_binary does not affect snapshots that are already loaded.
+         *
+         * If the file cannot be opened, an exception of type @c std::system_error is thrown. If it is not a compiled file,
+         * is damaged or was written by an incompatible version or platform, an exception of type @c parser_exception is thrown.
+         * @param path Path of the compiled file
+         * @return The snapshot
+         */
+        INICPP static frozen_ini load_binary(const std::string& path);
+
+        /**
+         * @brief Reads the configuration at @p path through the compiled cache at @p cache_path. The cache is keyed on a hash
+         * of the source text and the parser settings: if it matches, the cache is mapped as with @c load_binary. Otherwise
+         * the source is parsed and the cache is rewritten for the next start. A @c std::system_error while writing the cache,
+         * such as a read-only directory, is ignored: the snapshot is still returned, and the next start parses again.
+         *
+         * If the source cannot be opened, an exception of type @c std::system_error is thrown, and an exception of type
+         * @c parser_exception if it cannot be parsed.
+         * @param path Path of the configuration
+         * @param cache_path Path of the compiled cache
+         * @param options Comment handles and delimiter of the configuration
+         * @return The snapshot
+         */
+        INICPP static frozen_ini read_file_cached(const std::string& path, const std::string& cache_path, const parse_options& options = parse_options());
+
+        /**
+         * @brief Writes the snapshot to a compiled file that @c load_binary maps back. The file is replaced atomically, see
+         * @c ini::write_file. If it cannot be written, an exception of type @c std::system_error is thrown.
+         * @param path Path of the compiled file
+         */
+        inline void save_binary(const std::string& path) const { save_binary(path, 0); }
+
+        inline bool empty() const noexcept { return size() == 0; }
+
+        /**
+         * @brief Retrieves the number of sections
+         */
+        inline std::size_t size() const noexcept { return m_base ? header().section_count : 0; }
+
+        /**
+         * @brief Retrieves the number of bytes used by the snapshot
+         */
+        inline std::size_t storage_size() const noexcept { return m_base ? header().size : 0; }
+
+        /**
+         * @brief Finds a section. If the section does not exist, an invalid @c section is returned.
+         * @param name The name of the section
+         * @return A valid or invalid section
+         */
+        INICPP section find(std::string_view name) const noexcept;
+
+        inline section operator[](std::string_view name) const noexcept;
+
+        inline bool contains(std::string_view name) const noexcept;
+
+        inline const_iterator begin() const noexcept;
+        inline const_iterator cbegin() const noexcept;
+        inline const_iterator end() const noexcept;
+        inline const_iterator cend() const noexcept;
+    private:
+        inline frozen_ini(std::shared_ptr<const void> owner, const char* base) noexcept : m_owner(std::move(owner)), m_base(base) {}
+
+        // Lays out the sections and keys of @p source in a new blob
+        INICPP static frozen_ini build(const ini& source);
+
+        // Writes a compiled file keyed on @p source_hash
+        INICPP void save_binary(const std::string& path, std::uint64_t source_hash) const;
+
+        // Maps a compiled file. Returns an empty handle if the file is not valid or, if @p source_hash is given, was compiled from other text
+        INICPP static frozen_ini map_binary(const std::string& path, const std::uint64_t* source_hash);
+
+        inline const detail::frozen_header& header() const noexcept { return *reinterpret_cast<const detail::frozen_header*>(m_base); }
+
+        std::shared_ptr<const void> m_owner;
+        const char* m_base = nullptr;
+
+        friend class ini;
+    };
+
+    /**
+     * @brief A value of a @c frozen_ini. Offers the same conversions as @c ini_value.
+     */
+    class frozen_ini::value {
+    public:
+        constexpr value() noexcept = default;
+
+        constexpr inline bool has_value() const noexcept { return m_data != nullptr; }
+        constexpr inline explicit operator bool() const noexcept { return has_value(); }
+        constexpr inline bool operator !() const noexcept { return !operator bool(); }
+
+        /**
+         * @brief Retrieves the text of the value. If there is no value, an exception of type @c std::bad_optional_access is thrown.
+         */
+        inline std::string_view get_value() const {
+            if (!m_data) throw std::bad_optional_access();
+            return std::string_view(m_data, m_length);
+        }
+
+        template<typename T>
+        inline T as() const {
+            if (!m_data) throw std::bad_optional_access();
+            return detail::convert<T>(m_data, m_length);
+        }
+
+        /**
+         * @brief Converts the value like @c as, without throwing. See @c ini_value::try_as.
+         */
+        template<typename T>
+        inline std::optional<T> try_as() const noexcept(detail::is_nothrow_convertible<T>) {
+            T result{};
+            if (try_as(result) != std::errc()) return std::nullopt;
+            return result;
+        }
+
+        template<typename T>
+        inline std::errc try_as(T& out) const noexcept(detail::is_nothrow_convertible<T>) {
+            if (!m_data) return std::errc::invalid_argument;
+            return detail::try_convert(m_data, m_length, out);
+        }
+
+        template<typename T>
+        inline operator T() const { return as<T>(); }
+    private:
+        constexpr inline value(const char* data, std::size_t length) noexcept : m_data(data), m_length(length) {}
+
+        const char* m_data = nullptr;
+        std::size_t m_length = 0;
+
+        friend class frozen_ini;
+    };
+
+    /**
+     * @brief A section of a @c frozen_ini.
+     */
+    class frozen_ini::section {
+    public:
+        typedef iterator<std::pair<std::string_view, value>, detail::frozen_key> const_iterator;
+    public:
+        constexpr section() noexcept = default;
+
+        inline bool empty() const noexcept { return size() == 0; }
+        inline std::size_t size() const noexcept { return m_entry ? m_entry->key_count : 0; }
+
+        /**
+         * @brief Checks whether the section exists in the snapshot
+         */
+        constexpr inline explicit operator bool() const noexcept { return m_entry != nullptr; }
+        constexpr inline bool operator !() const noexcept { return !operator bool(); }
+
+        inline std::string_view get_name() const noexcept { return m_entry ? std::string_view(m_base + m_entry->name, m_entry->name_length) : std::string_view(); }
+
+        /**
+         * @brief Finds a key within the section. If the key does not exist, an invalid @c value is returned.
+         * @param key The key to find
+         * @return A valid or invalid value
+         */
+        INICPP value find(std::string_view key) const noexcept;
+
+        inline value operator[](std::string_view key) const noexcept { return find(key); }
+
+        inline bool contains(std::string_view key) const noexcept { return find(key).has_value(); }
+
+        inline const_iterator begin() const noexcept;
+        inline const_iterator cbegin() const noexcept;
+        inline const_iterator end() const noexcept;
+        inline const_iterator cend() const noexcept;
+    private:
+        constexpr inline section(const char* base, const detail::frozen_section* entry) noexcept : m_base(base), m_entry(entry) {}
+
+        inline const detail::frozen_key* keys() const noexcept {
+            auto const& header = *reinterpret_cast<const detail::frozen_header*>(m_base);
+            return reinterpret_cast<const detail::frozen_key*>(m_base + header.keys) + m_entry->first_key;
+        }
+
+        const char* m_base = nullptr;
+        const detail::frozen_section* m_entry = nullptr;
+
+        friend class frozen_ini;
+    };
+
+    /**
+     * @brief Forward iterator over the sections of a @c frozen_ini or the keys of a section. Dereferencing yields views by value.
+     */
+    template<typename T, typename Entry>
+    class frozen_ini::iterator {
+    public:
+        typedef T value_type;
+
+        inline value_type operator*() const noexcept { return make(std::is_same<Entry, detail::frozen_section>()); }
+
+        inline iterator& operator++() noexcept { ++m_entry; return *this; }
+        inline iterator operator++(int) noexcept { auto ret = *this; ++m_entry; return ret; }
+
+        inline bool operator==(const iterator& other) const noexcept { return m_entry == other.m_entry; }
+        inline bool operator!=(const iterator& other) const noexcept { return m_entry != other.m_entry; }
+    private:
+        constexpr inline iterator(const char* base, const Entry* entry) noexcept : m_base(base), m_entry(entry) {}
+
+        inline value_type make(std::true_type) const noexcept { return section(m_base, m_entry); }
+        inline value_type make(std::false_type) const noexcept {
+            return value_type(std::string_view(m_base + m_entry->name, m_entry->name_length), value(m_base + m_entry->value, m_entry->value_length));
+        }
+
+        const char* m_base;
+        const Entry* m_entry;
+
+        friend class frozen_ini;
+    };
+
+    inline frozen_ini::section frozen_ini::operator[](std::string_view name) const noexcept { return find(name); }
+
+    inline bool frozen_ini::contains(std::string_view name) const noexcept { return static_cast<bool>(find(name)); }
+
+    inline frozen_ini::const_iterator frozen_ini::begin() const noexcept {
+        return m_base ? const_iterator(m_base, reinterpret_cast<const detail::frozen_section*>(m_base + header().sections)) : const_iterator(nullptr, nullptr);
+    }
+
+    inline frozen_ini::const_iterator frozen_ini::cbegin() const noexcept { return begin(); }
+
+    inline frozen_ini::const_iterator frozen_ini::end() const noexcept {
+        return m_base ? const_iterator(m_base, reinterpret_cast<const detail::frozen_section*>(m_base + header().sections) + header().section_count) : const_iterator(nullptr, nullptr);
+    }
+
+    inline frozen_ini::const_iterator frozen_ini::cend() const noexcept { return end(); }
+
+    inline frozen_ini::section::const_iterator frozen_ini::section::begin() const noexcept {
+        return m_entry ? const_iterator(m_base, keys()) : const_iterator(nullptr, nullptr);
+    }
+
+    inline frozen_ini::section::const_iterator frozen_ini::section::cbegin() const noexcept { return begin(); }
+
+    inline frozen_ini::section::const_iterator frozen_ini::section::end() const noexcept {
+        return m_entry ? const_iterator(m_base, keys() + m_entry->key_count) : const_iterator(nullptr, nullptr);
+    }
+
+    inline frozen_ini::section::const_iterator frozen_ini::section::cend() const noexcept { return end(); }
+}
+
+#endif
@@ -4,18 +4,30 @@
 #include "config.h"
 
 #include "ini_section.hpp"
+#include "key_handle.hpp"
 #include "detail/reverse_iterator.h"
 #include "detail/section_iterator.h"
 
 #include <unordered_map>
 #include <list>
+#include <memory>
+#include <memory_resource>
+#include <cstddef>
 #include <type_traits>
 #include <istream>
 #include <ostream>
 #include <sstream>
+#include <string_view>
 #include <unordered_set>
+#include <vector>
 
 namespace inicpp {
+    // only used by reference here; include frozen_ini.hpp, thread_pool.hpp, parse_stats.hpp or parser.hpp to use them
+    class frozen_ini;
+    class thread_pool;
+    struct parse_stats;
+    struct parse_error;
+
     class ini {
     public:
         typedef detail::section_iterator<ini_section> iterator;
@@ -23,25 +35,235 @@ namespace inicpp {
 
         typedef detail::reverse_iterator<iterator> reverse_iterator;
         typedef detail::reverse_iterator<const_iterator> const_reverse_iterator;
+
+        typedef std::pmr::polymorphic_allocator<std::byte> allocator_type;
     public:
         ini() = default;
-        ini(const ini&) = default;
-        ini(ini&&) = default;
 
-        ini& operator=(const ini&) = default;
-        ini& operator=(ini&&) = default;
+        /**
+         * @brief Constructs an empty ini whose section list, lookup tables and key nodes are allocated from @p alloc. Names
+         * and values are @c std::string, so those too long for the small string buffer still come from the global heap.
+         * The memory resource must outlive the ini.
+         * @param alloc The allocator to use for the nodes of sections and keys
+         */
+        inline explicit ini(const allocator_type& alloc) : m_lookup_map(alloc), m_sections(alloc) {}
+
+        /**
+         * @brief Copies another ini. The copy allocates from the default memory resource.
+         */
+        inline ini(const ini& other) : ini(other, allocator_type()) {}
+        INICPP ini(const ini& other, const allocator_type& alloc);
+        INICPP ini(ini&& other) noexcept;
+
+        INICPP ini& operator=(const ini& other);
+        INICPP ini& operator=(ini&& other);
+
+        /**
+         * @brief Constructs an empty ini that owns a monotonic arena, which holds the section list, lookup tables and key
+         * nodes; see @c ini(const allocator_type&). Parsing a file into it takes a handful of arena blocks plus one heap
+         * allocation per name or value that does not fit into the small string buffer, and destroying it releases the arena
+         * at once. Memory of erased or overwritten entries is only reclaimed when the ini is destroyed.
+         * @param initial_size Size of the first block requested by the arena
+         * @return The arena-backed ini
+         */
+        INICPP static ini with_arena(std::size_t initial_size = std::size_t(64) * 1024);
+
+        /**
+         * @brief Constructs an empty ini that allocates from @p arena and keeps it alive. Several inis may share one arena,
+         * which is released when the last of them is destroyed; since arenas are not thread safe, inis that share one must
+         * not allocate from several threads at once.
+         * @param arena The resource to allocate from
+         * @return The arena-backed ini
+         */
+        INICPP static ini with_arena(std::shared_ptr<std::pmr::memory_resource> arena);
+
+        /**
+         * @brief Retrieves the allocator used for the sections and keys of this ini
+         * @return The associated allocator
+         */
+        inline allocator_type get_allocator() const noexcept { return m_sections.get_allocator(); }
 
         INICPP void read(std::istream& in);
-        inline void read(const std::string& s) { std::istringstream is(s); return read(is); }
-        inline void read(std::string&& s) { std::istringstream is(std::move(s)); return read(is); }
+        inline void read(const std::string& s) { read_buffer(s); }
+        inline void read(std::string&& s) { read_buffer(s); }
+
+        /**
+         * @brief Reads @p in like @c read(std::istream&), and records what was read and how long it took in @p stats.
+         * @param in The stream to read
+         * @param stats Reset and filled in, also if a @c parser_exception is thrown
+         */
+        INICPP void read(std::istream& in, parse_stats& stats);
+
+        /**
+         * @brief Reads @p s like @c read(const std::string&), and records what was read and how long it took in @p stats.
+         * @param s The configuration to read
+         * @param stats Reset and filled in, also if a @c parser_exception is thrown
+         */
+        inline void read(const std::string& s, parse_stats& stats) { read_buffer(s, &stats); }
+
+        /**
+         * @brief Reads @p in like @c read(std::istream&), but instead of throwing at the first malformed line, appends an
+         * error for every malformed line to @p errors, skips the line and goes on. After a malformed section header, the lines
+         * up to the next valid header are skipped as well, without errors of their own, so that their keys do not end up in
+         * the section before it. No messages are formatted; see @c to_string(const parse_error&).
+         * @param in The stream to read
+         * @param errors Receives the errors, in order
+         * @return Whether no errors were found
+         */
+        INICPP bool read(std::istream& in, std::vector<parse_error>& errors);
+
+        /**
+         * @brief Reads @p s, collecting errors instead of throwing them, see @c read(std::istream&, std::vector<parse_error>&).
+         * @param s The configuration to read
+         * @param errors Receives the errors, in order
+         * @return Whether no errors were found
+         */
+        inline bool read(const std::string& s, std::vector<parse_error>& errors) { return read_buffer(s, errors); }
+
+        /**
+         * @brief Reads the file at @p path. The file is memory mapped and parsed in place, without copying it into a stream.
+         * If the file cannot be opened, an exception of type @c std::system_error is thrown.
+         * @param path Path of the file to read
+         */
+        INICPP void read_file(const std::string& path);
+
+        /**
+         * @brief Reads the file at @p path like @c read_file(const std::string&), and records what was read and how long it
+         * took in @p stats. Mapping the file is not timed.
+         * @param path Path of the file to read
+         * @param stats Reset and filled in, also if a @c parser_exception is thrown
+         */
+        INICPP void read_file(const std::string& path, parse_stats& stats);
+
+        /**
+         * @brief Reads the file at @p path, collecting errors instead of throwing them, see
+         * @c read(std::istream&, std::vector<parse_error>&). If the file cannot be opened, an exception of type
+         * @c std::system_error is still thrown.
+         * @param path Path of the file to read
+         * @param errors Receives the errors, in order
+         * @return Whether no errors were found
+         */
+        INICPP bool read_file(const std::string& path, std::vector<parse_error>& errors);
+
+        /**
+         * @brief Reads @p buffer on the workers of @p pool, with the same result as @c read. The buffer is cut into chunks
+         * at section header lines, the chunks are parsed into local section lists concurrently and the lists are merged in
+         * file order; a section that appears in several chunks is merged key by key, just like a repeated header is when
+         * reading serially. The calling thread parses chunks as well, so this may be called from a task of @p pool.
+         * Buffers too small to be worth splitting are read on the calling thread.
+         *
+         * Sections are only handed over without copying if the allocator of this ini can be used from several threads
+         * (the default resource or a @c std::pmr::synchronized_pool_resource); otherwise the parsed keys are copied in.
+         * If the buffer cannot be parsed, the sections before the error are read and a @c parser_exception is thrown, as with @c read.
+         * @param buffer The configuration to read
+         * @param pool Threads to parse on
+         */
+        INICPP void read_parallel(std::string_view buffer, thread_pool& pool);
+
+        /**
+         * @brief Reads the file at @p path in parallel, see @c read_parallel. The file is memory mapped.
+         * If the file cannot be opened, an exception of type @c std::system_error is thrown.
+         * @param path Path of the file to read
+         * @param pool Threads to parse on
+         */
+        INICPP void read_file_parallel(const std::string& path, thread_pool& pool);
+
+        /**
+         * @brief Replaces the contents of this ini with the configuration in @p buffer, re-parsing only what changed since the
+         * last reload. The buffer is split at section headers and each section is hashed; a section whose text and settings
+         * are unchanged, and which has not been modified through the API since, is kept as is, so references to it and to its
+         * values stay valid. Changed sections get new values, new sections are added and sections that are gone are removed.
+         * Sections whose header appears more than once are not tracked, and cause the whole buffer to be parsed again.
+         *
+         * If the buffer cannot be parsed, an exception of type @c parser_exception is thrown and the ini is left unchanged.
+         * @param buffer The new contents
+         */
+        INICPP void reload(std::string_view buffer);
+
+        /**
+         * @brief Reloads @p buffer like @c reload(std::string_view), and records what was done in @p stats. Only the sections
+         * that were parsed again are counted, as if they had been read into an empty ini; the sections that were kept are
+         * counted as unchanged.
+         * @param buffer The new contents
+         * @param stats Reset and filled in, also if a @c parser_exception is thrown
+         */
+        INICPP void reload(std::string_view buffer, parse_stats& stats);
+
+        /**
+         * @brief Replaces the contents of this ini with the file at @p path, re-parsing only the sections that changed since
+         * the last reload. See @c reload. The file is read into a buffer rather than memory mapped, so it may be rewritten
+         * in place while it is reloaded; the reload then sees a mix of old and new text, which the next reload corrects.
+         * If the file cannot be opened, an exception of type @c std::system_error is thrown.
+         * @param path Path of the file to read
+         */
+        INICPP void reload_file(const std::string& path);
+
+        /**
+         * @brief Reloads the file at @p path like @c reload_file(const std::string&), and records what was done in @p stats.
+         * See @c reload(std::string_view, parse_stats&).
+         * @param path Path of the file to read
+         * @param stats Reset and filled in, also if a @c parser_exception is thrown
+         */
+        INICPP void reload_file(const std::string& path, parse_stats& stats);
+
+        /**
+         * @brief Creates an immutable snapshot of the sections and keys of this ini. The snapshot is independent of the ini,
+         * uses a fraction of its memory and can be read concurrently without locking.
+         * @return The frozen snapshot
+         */
+        INICPP frozen_ini freeze() const;
+
+        /**
+         * @brief Writes a compiled snapshot of this ini, which @c load_binary and @c frozen_ini::load_binary read back without
+         * parsing. See @c frozen_ini::save_binary.
+         * @param path Path of the compiled file
+         */
+        INICPP void save_binary(const std::string& path) const;
+
+        /**
+         * @brief Replaces the contents of this ini with a compiled file written by @c save_binary. The file is mapped and
+         * the sections are copied out of it, without tokenizing any text. Errors are reported as by @c frozen_ini::load_binary.
+         * @param path Path of the compiled file
+         */
+        INICPP void load_binary(const std::string& path);
+
+        /**
+         * @brief Replaces the contents of this ini with the file at @p path, going through the compiled cache at
+         * @p cache_path: if the cache was compiled from the same text with the same comment handles and delimiter, it is
+         * loaded instead of the text; otherwise the text is parsed and the cache rewritten. Failures to write the cache are
+         * ignored. See @c frozen_ini::read_file_cached.
+         * If the file cannot be parsed, an exception of type @c parser_exception is thrown and the ini is left unchanged.
+         * @param path Path of the file to read
+         * @param cache_path Path of the compiled cache
+         */
+        INICPP void read_file_cached(const std::string& path, const std::string& cache_path);
 
         INICPP void write(std::ostream& out) const;
-        inline void write(std::string& out) const { std::ostringstream os; write(os);out = os.str(); }
+
+        /**
+         * @brief Writes the ini into @p out, replacing its contents. The exact size of the output is computed first, so the
+         * text is formatted straight into a single allocation.
+         * @param out Receives the text
+         */
+        INICPP void write(std::string& out) const;
+
+        /**
+         * @brief Writes the ini to the file at @p path, replacing it atomically: the text is written with a single call to
+         * a temporary file next to @p path, flushed to disk and renamed over the old file, so readers see either the old
+         * or the new contents and never a partial file. If the file cannot be written, an exception of type
+         * @c std::system_error is thrown and the old file is left untouched.
+         * @param path Path of the file to write
+         */
+        INICPP void write_file(const std::string& path) const;
 
         inline bool empty() const noexcept { return m_sections.empty() || begin() == end(); }
 
         // Clears temporary inexistent sections
-        inline void clear() noexcept { m_lookup_map.clear(); m_sections.clear(); }
+        inline void clear() noexcept {
+            m_lookup_map.clear();
+            m_sections.clear();
+            m_generation = next_generation();
+        }
 
         inline void push_front(const ini_section& value) { insert(cbegin(), value); }
 
@@ -54,16 +276,61 @@ namespace inicpp {
         INICPP ini_section& find(const std::string& name);
         INICPP ini_section& find(std::string&& name);
 
-        INICPP ini_section const& find(const std::string& name) const;
-        INICPP ini_section const& find(std::string&& name) const;
+        INICPP ini_section& find(std::string_view name);
+        inline ini_section& find(const char* name) { return find(std::string_view(name)); }
+
+        /**
+         * @brief Finds a section without modifying the ini. If the section does not exist, a reference to a shared invalid
+         * @c ini_section is returned, so looking up missing sections of a @c const ini is safe from several threads.
+         * @param name The name of the section
+         * @return A valid or invalid ini_section
+         */
+        INICPP ini_section const& find(std::string_view name) const;
+        inline ini_section const& find(const char* name) const { return find(std::string_view(name)); }
+
+        /**
+         * @brief Finds a section without inserting anything on a miss.
+         * @param name The name of the section
+         * @return Pointer to the section, or @c nullptr if it does not exist
+         */
+        INICPP ini_section* try_get(std::string_view name) noexcept;
+        INICPP ini_section const* try_get(std::string_view name) const noexcept;
+
+        /**
+         * @brief Creates a handle to a key for repeated lookups, see @c key_handle. The key does not have to exist yet.
+         * @param section The name of the section
+         * @param key The name of the key
+         * @return The handle, already resolved if the key exists
+         */
+        inline key_handle handle(std::string_view section, std::string_view key) const {
+            key_handle result{ std::string(section), std::string(key) };
+            try_get(result);
+            return result;
+        }
+
+        /**
+         * @brief Finds the key named by @p handle. If nothing was erased, replaced or renamed and nothing was read into the
+         * ini since the handle was last resolved against it, this skips both lookups; otherwise the key is looked up by name
+         * and the handle remembers the result. Adding sections or keys does not invalidate handles.
+         * @param handle The handle to resolve
+         * @return Pointer to the value, or @c nullptr if the key does not exist or has no value
+         */
+        inline ini_value* try_get(key_handle& handle) noexcept { return const_cast<ini_value*>(static_cast<const ini&>(*this).try_get(handle)); }
+
+        inline const ini_value* try_get(key_handle& handle) const noexcept {
+            if (handle.m_generation == m_generation) return handle.m_value->has_value() ? handle.m_value : nullptr;
+            return resolve(handle);
+        }
 
         inline ini_section& operator[](const std::string& key) { return find(key); }
         inline ini_section& operator[](std::string&& key) { return find(std::move(key)); }
+        inline ini_section& operator[](std::string_view key) { return find(key); }
+        inline ini_section& operator[](const char* key) { return find(key); }
 
-        inline const ini_section& operator[](const std::string& key) const { return find(key); }
-        inline const ini_section& operator[](std::string&& key) const { return find(std::move(key)); }
+        inline const ini_section& operator[](std::string_view key) const { return find(key); }
+        inline const ini_section& operator[](const char* key) const { return find(key); }
 
-        INICPP bool contains(const std::string& name) const;
+        INICPP bool contains(std::string_view name) const;
 
         INICPP ini_section& insert(const_iterator pos, ini_section const& sec);
         INICPP ini_section& insert(const_iterator pos, ini_section&& sec);
@@ -72,6 +339,7 @@ namespace inicpp {
             if (pos == cend() || !contains(pos->get_name())) return end();
             m_lookup_map.erase(pos->get_name());
             auto next = m_sections.erase(pos.m_cur);
+            m_generation = next_generation();
             return iterator(next, m_sections);
         }
 
@@ -82,13 +350,13 @@ namespace inicpp {
          */
         inline iterator erase(const_iterator pos) { return remove(pos); }
 
-        inline bool remove(const std::string& key) {
+        inline bool remove(std::string_view key) {
             if (!contains(key)) { return false; }
             remove(const_iterator(m_lookup_map.find(key)->second, m_sections));
             return true;
         }
 
-        inline bool erase(const std::string& key) { return remove(key); }
+        inline bool erase(std::string_view key) { return remove(key); }
 
         inline ini_section& back() noexcept { return *--end(); }
 
@@ -132,12 +400,45 @@ namespace inicpp {
         inline void set_delimeter(std::string&& new_delim) noexcept { this->m_delim = std::move(new_delim); }
 
     private:
-        mutable std::unordered_map<std::string, typename std::list<ini_section>::iterator> m_lookup_map;
-        mutable std::list<ini_section> m_sections;
+        struct reader;
+
+        // Reads @p buffer, counting into @p stats if it is set
+        INICPP void read_buffer(std::string_view buffer, parse_stats* stats = nullptr);
+
+        // Reads @p buffer, appending its errors to @p errors
+        INICPP bool read_buffer(std::string_view buffer, std::vector<parse_error>& errors);
+
+        // Reloads @p buffer, counting into @p stats if it is set
+        INICPP void reload_buffer(std::string_view buffer, parse_stats* stats);
+
+        // Replaces the contents of this ini with the sections of @p snapshot
+        INICPP void thaw(const frozen_ini& snapshot);
+
+        // Looks up the key of @p handle by name and stores the result in it
+        INICPP const ini_value* resolve(key_handle& handle) const noexcept;
+
+        // Draws a generation that no ini has had before, so a handle can only ever match the ini that resolved it
+        INICPP static std::uint64_t next_generation() noexcept;
+
+        // Shared invalid section returned by const lookups that miss
+        INICPP static ini_section const& missing_section() noexcept;
+
+        // Points the sections of this ini back at it after they have been moved in
+        inline void adopt_sections() noexcept { for (auto& section : m_sections) section.m_ini = this; }
+
+        // Owned arena for ini::with_arena, declared first so that it outlives the containers allocated from it
+        std::shared_ptr<std::pmr::memory_resource> m_arena;
+        // keyed by views of the names owned by the sections themselves, see ini_section::set_name
+        std::pmr::unordered_map<std::string_view, typename std::pmr::list<ini_section>::iterator> m_lookup_map;
+        std::pmr::list<ini_section> m_sections;
         std::unordered_set<std::string> m_comment_handles = { "//", "#", ";" };
         std::string m_delim = "=";
+        // changes whenever values may have been destroyed, renamed or replaced, see key_handle
+        std::uint64_t m_generation = next_generation();
 
         friend class ini_section;
+        friend class file_watcher;
+        friend class frozen_ini;
     };
 
     inline std::istream& operator>>(std::istream& in, ini& ini) {
@@ -8,6 +8,11 @@
 #include "detail/reverse_iterator.h"
 
 #include <stdexcept>
+#include <cstddef>
+#include <cstdint>
+#include <memory_resource>
+#include <string>
+#include <string_view>
 
 namespace inicpp {
     class ini;
@@ -20,17 +25,25 @@ namespace inicpp {
 
         typedef detail::reverse_iterator<iterator> reverse_iterator;
         typedef detail::reverse_iterator<const_iterator> const_reverse_iterator;
+
+        typedef std::pmr::polymorphic_allocator<std::byte> allocator_type;
     public:
         ini_section() = default;
+        inline explicit ini_section(const allocator_type& alloc);
         inline ini_section(const ini_section&);
+        inline ini_section(const ini_section&, const allocator_type& alloc);
         inline ini_section(ini_section&&);
-        inline ini_section(const std::string& name);
-        inline ini_section(std::string&& name);
+        inline ini_section(ini_section&&, const allocator_type& alloc);
+        inline ini_section(const std::string& name, const allocator_type& alloc = allocator_type());
+        inline ini_section(std::string&& name, const allocator_type& alloc = allocator_type());
 
         inline ini_section& operator=(const ini_section& other) {
             this->m_data = other.m_data;
             this->m_exists = (this->m_ini && !other.empty()) || this->m_exists;
             this->set_name(other.m_name);
+            this->m_source_hash = 0;
+            adopt_values();
+            invalidate_handles();
             return *this;
         }
 
@@ -38,9 +51,18 @@ namespace inicpp {
             this->m_data = std::move(other.m_data);
             this->m_exists = (this->m_ini && !other.empty()) || this->m_exists;
             this->set_name(std::move(other.m_name));
+            this->m_source_hash = 0;
+            adopt_values();
+            invalidate_handles();
             return *this;
         }
 
+        /**
+         * @brief Retrieves the allocator used for the keys and values of this section
+         * @return The associated allocator
+         */
+        inline allocator_type get_allocator() const noexcept { return m_data.get_allocator(); }
+
         inline bool empty() const noexcept { return m_data.empty() || begin() == end(); }
 
         /**
@@ -67,17 +89,53 @@ namespace inicpp {
 
         /**
          * @brief Attempts to find a key within the ini section. If the key does not exist, an invalid @c ini_value is returned.
+         * The key is only copied if it has to be inserted.
+         * @param key The key to find
+         * @return A valid or invalid ini_value
+         */
+        inline ini_value& find(std::string_view key) {
+            auto& v = m_data[key];
+            v.m_section = this;
+            return v;
+        }
+
+        /**
+         * @brief Attempts to find a key within the ini section. If the key does not exist, an invalid @c ini_value is returned.
+         * The key is only copied if it has to be inserted.
+         * @param key The key to find
+         * @return A valid or invalid ini_value
+         */
+        inline ini_value& find(const char* key) { return find(std::string_view(key)); }
+
+        /**
+         * @brief Finds a key without modifying the section. If the key does not exist, a reference to a shared invalid
+         * @c ini_value is returned, so looking up missing keys of a @c const section is safe from several threads.
          * @param key The key to find
          * @return A valid or invalid ini_value
          */
-        INICPP const ini_value& find(const std::string& key) const;
+        INICPP const ini_value& find(std::string_view key) const;
 
         /**
          * @brief Attempts to find a key within the ini section. If the key does not exist, an invalid @c ini_value is returned.
          * @param key The key to find
          * @return A valid or invalid ini_value
          */
-        INICPP const ini_value& find(std::string&& key) const;
+        inline const ini_value& find(const char* key) const { return find(std::string_view(key)); }
+
+        /**
+         * @brief Finds a key without inserting anything on a miss.
+         * @param key The key to find
+         * @return Pointer to the value, or @c nullptr if the key does not exist or has no value
+         */
+        inline ini_value* try_get(std::string_view key) noexcept {
+            auto f = m_data.find(key);
+            return f != m_data.end() && f->second ? &f->second : nullptr;
+        }
+
+        inline const ini_value* try_get(std::string_view key) const noexcept {
+            auto f = m_data.find(key);
+            return f != m_data.end() && f->second ? &f->second : nullptr;
+        }
 
         inline void push_front(const typename detail::ordered_map<std::string, ini_value>::value_type& value) { insert(cbegin(), value); }
 
@@ -97,6 +155,7 @@ namespace inicpp {
             auto i = m_data.insert(pos.m_cur, value);
             i->second.m_section = this;
             m_exists = m_exists || i->second.has_value();
+            m_source_hash = 0;
             return i->second;
         }
 
@@ -110,6 +169,7 @@ namespace inicpp {
             auto i = m_data.insert(pos.m_cur, std::move(value));
             i->second.m_section = this;
             m_exists = m_exists || i->second.has_value();
+            m_source_hash = 0;
             return i->second;
         }
 
@@ -119,12 +179,13 @@ namespace inicpp {
          * @param value The value to replace
          * @return The old value associated with this key
          */
-        inline ini_value replace(const std::string& key, const ini_value& value) {
+        inline ini_value replace(std::string_view key, const ini_value& value) {
             if (!contains(key)) { throw std::invalid_argument("ini_section::replace"); }
             auto f = m_data.find(key);
             ini_value old = f->second;
             f->second = value;
             f->second.m_section = this;
+            m_source_hash = 0;
             return old;
         }
 
@@ -134,12 +195,13 @@ namespace inicpp {
          * @param value The value to replace
          * @return The old value associated with this key
          */
-        inline ini_value replace(const std::string& key, ini_value&& value) {
+        inline ini_value replace(std::string_view key, ini_value&& value) {
             if (!contains(key)) { throw std::invalid_argument("ini_section::replace"); }
             auto f = m_data.find(key);
             ini_value old = f->second;
             f->second = std::move(value);
             f->second.m_section = this;
+            m_source_hash = 0;
             return old;
         }
 
@@ -148,9 +210,11 @@ namespace inicpp {
          * @param key The key to remove
          * @return True if the element has been removed, false if it did not exist
          */
-        inline bool remove(const std::string& key) {
+        inline bool remove(std::string_view key) {
             if (!contains(key)) { return false; }
             m_data.erase(key);
+            m_source_hash = 0;
+            invalidate_handles();
             return true;
         }
 
@@ -159,14 +223,14 @@ namespace inicpp {
          * @param key The key to remove
          * @return True if the element has been removed, false if it did not exist
          */
-        inline bool erase(const std::string& key) { return remove(key); }
+        inline bool erase(std::string_view key) { return remove(key); }
 
         /**
          * @brief Checks whether the section contains the specified key
          * @param key Name of the key to check
          * @return True if the sections contains the underlying key, false otherwise.
          */
-        inline bool contains(const std::string& key) const {
+        inline bool contains(std::string_view key) const {
             auto f = m_data.find(key);
             return f != m_data.end() && (f->second);
         }
@@ -174,7 +238,11 @@ namespace inicpp {
         /**
          * @brief Clears the contents of the section.
          */
-        inline void clear() noexcept { return m_data.clear(); }
+        inline void clear() noexcept {
+            m_data.clear();
+            m_source_hash = 0;
+            invalidate_handles();
+        }
 
         /**
          * @brief Retrieves the name of the ini section
@@ -206,8 +274,11 @@ namespace inicpp {
         inline ini_value& operator[](const std::string& key) { return find(key); }
         inline ini_value& operator[](std::string&& key) { return find(std::move(key)); }
 
-        inline const ini_value& operator[](const std::string& key) const { return find(key); }
-        inline const ini_value& operator[](std::string&& key) const { return find(std::move(key)); }
+        inline ini_value& operator[](std::string_view key) { return find(key); }
+        inline ini_value& operator[](const char* key) { return find(key); }
+
+        inline const ini_value& operator[](std::string_view key) const { return find(key); }
+        inline const ini_value& operator[](const char* key) const { return find(key); }
 
         inline typename detail::ordered_map<std::string, ini_value>::value_type& front() noexcept { return *begin(); }
         inline typename detail::ordered_map<std::string, ini_value>::value_type const& front() const noexcept { return *begin(); }
@@ -229,20 +300,43 @@ namespace inicpp {
         inline const_reverse_iterator rend() const noexcept { return const_reverse_iterator(begin()); }
         inline const_reverse_iterator rcend() const noexcept { return const_reverse_iterator(cbegin()); }
     private:
+        // Shared invalid value returned by const lookups that miss
+        INICPP static const ini_value& missing_value() noexcept;
+
+        // Marks the section as existing and modified
+        inline void touch() noexcept {
+            m_exists = true;
+            m_source_hash = 0;
+        }
+
+        // Tells the ini that values of this section were destroyed or renamed, see key_handle
+        INICPP void invalidate_handles() noexcept;
+
+        // Points the values of this section back at it after they have been copied or moved in
+        inline void adopt_values() noexcept { for (auto& value : m_data) value.second.m_section = this; }
+
         std::string m_name;
-        mutable detail::ordered_map<std::string, ini_value> m_data;
-        mutable bool m_exists = true;
+        detail::ordered_map<std::string, ini_value> m_data;
+        bool m_exists = true;
+
+        // Hash of the text this section was last parsed from by ini::reload, or 0 if unknown or modified since
+        std::uint64_t m_source_hash = 0;
         ini* m_ini = nullptr;
 
         friend class ini;
         friend class ini_value;
     };
 
-    inline ini_section::ini_section(const ini_section& other) : m_data(other.m_data) { this->set_name(other.m_name); }
-    inline ini_section::ini_section(ini_section&& other) : m_data(std::move(other.m_data)) { this->set_name(std::move(other.m_name)); }
+    inline ini_section::ini_section(const allocator_type& alloc) : m_data(alloc) {}
+
+    inline ini_section::ini_section(const ini_section& other) : ini_section(other, allocator_type()) {}
+    inline ini_section::ini_section(const ini_section& other, const allocator_type& alloc) : m_name(other.m_name), m_data(other.m_data, alloc) { adopt_values(); }
+
+    inline ini_section::ini_section(ini_section&& other) : m_name(std::move(other.m_name)), m_data(std::move(other.m_data)) { adopt_values(); }
+    inline ini_section::ini_section(ini_section&& other, const allocator_type& alloc) : m_name(std::move(other.m_name)), m_data(std::move(other.m_data), alloc) { adopt_values(); }
 
-    inline ini_section::ini_section(const std::string& name) { this->set_name(name); }
-    inline ini_section::ini_section(std::string&& name) { this->set_name(std::move(name)); }
+    inline ini_section::ini_section(const std::string& name, const allocator_type& alloc) : m_name(name), m_data(alloc) {}
+    inline ini_section::ini_section(std::string&& name, const allocator_type& alloc) : m_name(std::move(name)), m_data(alloc) {}
 }
 
 #endif
\ No newline at end of file
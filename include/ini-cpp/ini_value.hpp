@@ -2,11 +2,16 @@
 #define INICPP_INI_VALUE_H 1
 
 #include "config.h"
+#include "detail/convert.h"
+#include "detail/conversion_cache.h"
 
+#include <charconv>
 #include <string>
+#include <string_view>
 #include <limits>
 #include <stdexcept>
 #include <optional>
+#include <system_error>
 
 namespace inicpp {
     class ini;
@@ -14,8 +19,8 @@ namespace inicpp {
     class ini_value {
     public:
         constexpr ini_value() noexcept = default;
-        constexpr ini_value(const ini_value&) = default;
-        constexpr ini_value(ini_value&&) noexcept = default;
+        ini_value(const ini_value&) = default;
+        ini_value(ini_value&&) noexcept = default;
         constexpr inline ini_value(const std::string& data);
         constexpr inline ini_value(std::string&& data) noexcept;
 
@@ -28,20 +33,66 @@ namespace inicpp {
         INICPP void set_value(const std::string& data);
         INICPP void set_value(std::string&& data) noexcept;
 
+        /**
+         * @brief Converts the value to T. Conversions to integer types, float and double are cached, so converting the
+         * same value to the same type again does not parse it again; changing the value clears the cache. The cache adds
+         * 16 bytes to every value.
+         */
         template<typename T>
         T as() const;
 
+        /**
+         * @brief Converts the value like @c as, without throwing. Numbers have to span the whole value.
+         * @return The converted value, or an empty optional if there is no value or it cannot be converted to T
+         */
+        template<typename T>
+        inline std::optional<T> try_as() const noexcept(detail::is_nothrow_convertible<T>);
+
+        /**
+         * @brief Converts the value into @p out without throwing. Numbers have to span the whole value.
+         * @param out Receives the converted value; left unchanged on failure
+         * @return @c std::errc() on success, @c std::errc::invalid_argument if there is no value or it is not a T and
+         * @c std::errc::result_out_of_range if the number does not fit into T
+         */
+        template<typename T>
+        inline std::errc try_as(T& out) const noexcept(detail::is_nothrow_convertible<T>);
+
         template<typename T>
         inline operator T() const { return as<T>(); }
 
-        constexpr ini_value& operator =(const ini_value&) = default;
-        constexpr ini_value& operator =(ini_value&&) noexcept = default;
+        /**
+         * @brief Copies the text and cached conversion of @p other. The value stays in its own section, which is marked as
+         * modified, so that a reload parses it again.
+         */
+        INICPP ini_value& operator =(const ini_value& other);
+
+        /**
+         * @brief Moves the text and cached conversion of @p other. The value stays in its own section, which is marked as
+         * modified, so that a reload parses it again.
+         */
+        INICPP ini_value& operator =(ini_value&& other) noexcept;
 
         template<typename T>
         ini_value& operator =(T);
     private:
+        // Assigns the value in place, reusing the storage of the current value when possible
+        INICPP void assign(std::string_view data);
+
+        // Writes a number in its shortest form that reads back to the same value, without a temporary string
+        template<typename T>
+        inline ini_value& assign_number(T num) {
+            char buffer[64];
+            auto const result = std::to_chars(buffer, buffer + sizeof(buffer), num);
+            assign(std::string_view(buffer, result.ptr - buffer));
+
+            // the text converts back to exactly this number, so there is no need to parse it on the next as<T>()
+            if constexpr (detail::conversion_cache::is_cached<T>) m_cache.store(num);
+            return *this;
+        }
+
         std::optional<std::string> m_data;
         ini_section* m_section = nullptr;
+        detail::conversion_cache m_cache;
 
         friend class ini_section;
         friend class ini;
@@ -50,76 +101,38 @@ namespace inicpp {
     constexpr inline ini_value::ini_value(const std::string& data) : m_data(data) {}
     constexpr inline ini_value::ini_value(std::string&& data) noexcept : m_data(std::move(data)) {}
 
-    template<>
-    inline const char* ini_value::as() const { return get_value().c_str(); }
+    template<typename T>
+    inline T ini_value::as() const {
+        if constexpr (detail::conversion_cache::is_cached<T>) {
+            T result;
+            if (m_cache.load(result)) return result;
 
-    template<>
-    inline const std::string& ini_value::as() const { return get_value(); }
-
-    template<>
-    inline std::string ini_value::as() const { return get_value(); }
-
-    template<>
-    inline unsigned long long ini_value::as() const { return std::stoull(get_value()); }
-
-    template<>
-    inline signed long long ini_value::as() const { return std::stoll(get_value()); }
-
-    template<>
-    inline unsigned long ini_value::as() const { return std::stoul(get_value()); }
-
-    template<>
-    inline signed long ini_value::as() const { return std::stol(get_value()); }
-
-    template<>
-    inline unsigned int ini_value::as() const {
-        unsigned long val = as<unsigned long>();
-        if (val < std::numeric_limits<unsigned int>::min() || val > std::numeric_limits<unsigned int>::max())
-            throw std::out_of_range("stoui");
-        return static_cast<unsigned int>(val);
+            auto const& value = get_value();
+            result = detail::convert<T>(value.c_str(), value.length());
+            m_cache.store(result);
+            return result;
+        } else {
+            auto const& value = get_value();
+            return detail::convert<T>(value.c_str(), value.length());
+        }
     }
 
     template<>
-    inline signed int ini_value::as() const { return std::stoi(get_value()); }
-
-    template<>
-    inline unsigned short ini_value::as() const {
-        unsigned long val = as<unsigned long>();
-        if (val < std::numeric_limits<unsigned short>::min() || val > std::numeric_limits<unsigned short>::max())
-            throw std::out_of_range("stous");
-        return static_cast<unsigned short>(val);
-    }
+    inline const std::string& ini_value::as() const { return get_value(); }
 
-    template<>
-    inline signed short ini_value::as() const {
-        int val = as<int>();
-        if (val < std::numeric_limits<short>::min() || val > std::numeric_limits<short>::max())
-            throw std::out_of_range("stos");
-        return static_cast<short>(val);
+    template<typename T>
+    inline std::optional<T> ini_value::try_as() const noexcept(detail::is_nothrow_convertible<T>) {
+        T result{};
+        if (try_as(result) != std::errc()) return std::nullopt;
+        return result;
     }
 
-    template<>
-    inline char ini_value::as() const {
-        if (get_value().length() != 1)
-            throw std::length_error("ini_value::get_value()::length() != 1");
-        return get_value()[0];
+    template<typename T>
+    inline std::errc ini_value::try_as(T& out) const noexcept(detail::is_nothrow_convertible<T>) {
+        if (!m_data) return std::errc::invalid_argument;
+        return detail::try_convert(m_data->c_str(), m_data->length(), out);
     }
 
-    template<>
-    inline unsigned char ini_value::as() const { return static_cast<unsigned char>(as<char>()); }
-
-    template<>
-    inline signed char ini_value::as() const { return static_cast<signed char>(as<char>()); }
-
-    template<>
-    inline float ini_value::as() const { return std::stof(get_value()); }
-
-    template<>
-    inline double ini_value::as() const { return std::stod(get_value()); }
-
-    template<>
-    inline long double ini_value::as() const { return std::stold(get_value()); }
-
     template<>
     inline ini_value& ini_value::operator =(const std::string& str) {
         this->set_value(str);
@@ -133,58 +146,46 @@ namespace inicpp {
     }
 
     template<>
-    inline ini_value& ini_value::operator =(const char* const str) {
-        this->set_value(std::string(str));
+    inline ini_value& ini_value::operator =(std::string str) {
+        this->set_value(std::move(str));
         return *this;
     }
 
     template<>
-    inline ini_value& ini_value::operator =(unsigned long long num) {
-        this->set_value(std::to_string(num));
+    inline ini_value& ini_value::operator =(std::string_view str) {
+        this->assign(str);
         return *this;
     }
 
     template<>
-    inline ini_value& ini_value::operator =(signed long long num) {
-        this->set_value(std::to_string(num));
+    inline ini_value& ini_value::operator =(const char* const str) {
+        this->set_value(std::string(str));
         return *this;
     }
 
     template<>
-    inline ini_value& ini_value::operator =(unsigned long num) {
-        this->set_value(std::to_string(num));
-        return *this;
-    }
+    inline ini_value& ini_value::operator =(unsigned long long num) { return assign_number(num); }
 
     template<>
-    inline ini_value& ini_value::operator =(signed long num) {
-        this->set_value(std::to_string(num));
-        return *this;
-    }
+    inline ini_value& ini_value::operator =(signed long long num) { return assign_number(num); }
 
     template<>
-    inline ini_value& ini_value::operator =(unsigned int num) {
-        this->set_value(std::to_string(num));
-        return *this;
-    }
+    inline ini_value& ini_value::operator =(unsigned long num) { return assign_number(num); }
 
     template<>
-    inline ini_value& ini_value::operator =(signed int num) {
-        this->set_value(std::to_string(num));
-        return *this;
-    }
+    inline ini_value& ini_value::operator =(signed long num) { return assign_number(num); }
 
     template<>
-    inline ini_value& ini_value::operator =(unsigned short num) {
-        this->set_value(std::to_string(num));
-        return *this;
-    }
+    inline ini_value& ini_value::operator =(unsigned int num) { return assign_number(num); }
 
     template<>
-    inline ini_value& ini_value::operator =(signed short num) {
-        this->set_value(std::to_string(num));
-        return *this;
-    }
+    inline ini_value& ini_value::operator =(signed int num) { return assign_number(num); }
+
+    template<>
+    inline ini_value& ini_value::operator =(unsigned short num) { return assign_number(num); }
+
+    template<>
+    inline ini_value& ini_value::operator =(signed short num) { return assign_number(num); }
 
     template<>
     inline ini_value& ini_value::operator =(char c) {
@@ -199,22 +200,13 @@ namespace inicpp {
     inline ini_value& ini_value::operator =(unsigned char c) { return operator=(static_cast<char>(c)); }
 
     template<>
-    inline ini_value& ini_value::operator =(float num) {
-        this->set_value(std::to_string(num));
-        return *this;
-    }
+    inline ini_value& ini_value::operator =(float num) { return assign_number(num); }
 
     template<>
-    inline ini_value& ini_value::operator =(double num) {
-        this->set_value(std::to_string(num));
-        return *this;
-    }
+    inline ini_value& ini_value::operator =(double num) { return assign_number(num); }
 
     template<>
-    inline ini_value& ini_value::operator =(long double num) {
-        this->set_value(std::to_string(num));
-        return *this;
-    }
+    inline ini_value& ini_value::operator =(long double num) { return assign_number(num); }
 }
 
 #endif
\ No newline at end of file
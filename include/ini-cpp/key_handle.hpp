@@ -0,0 +1,42 @@
+#ifndef INICPP_KEY_HANDLE_H
+#define INICPP_KEY_HANDLE_H 1
+
+#include "config.h"
+
+#include <cstdint>
+#include <string>
+#include <utility>
+
+namespace inicpp {
+    class ini;
+    class ini_value;
+
+    /**
+     * @brief Names a key of an @c ini and remembers where it was found. Created by @c ini::handle and resolved by
+     * @c ini::try_get(key_handle&). As long as the ini has not been structurally modified since the handle was last
+     * resolved, resolving it again is a compare and a pointer load; otherwise the key is looked up by name again.
+     *
+     * Resolving updates the handle, so a handle must not be resolved from several threads at once. Give each thread its
+     * own copy instead.
+     */
+    class key_handle {
+    public:
+        key_handle() = default;
+
+        inline key_handle(std::string section, std::string key) : m_section(std::move(section)), m_key(std::move(key)) {}
+
+        inline const std::string& section() const noexcept { return m_section; }
+        inline const std::string& key() const noexcept { return m_key; }
+    private:
+        std::string m_section;
+        std::string m_key;
+
+        // the value found by the last lookup, valid while the ini is still at m_generation; generations start at 1
+        const ini_value* m_value = nullptr;
+        std::uint64_t m_generation = 0;
+
+        friend class ini;
+    };
+}
+
+#endif
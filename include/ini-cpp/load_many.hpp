@@ -0,0 +1,67 @@
+#ifndef INICPP_LOAD_MANY_H
+#define INICPP_LOAD_MANY_H 1
+
+#include "config.h"
+#include "ini.hpp"
+#include "parser.hpp"
+#include "thread_pool.hpp"
+
+#include <cstddef>
+#include <exception>
+#include <string>
+#include <vector>
+
+namespace inicpp {
+    /**
+     * @brief Settings of @c load_many.
+     */
+    struct load_options {
+        // comment handles and delimiter of every document
+        parse_options syntax;
+
+        // If not 0, documents loaded one after another by the same thread share a monotonic arena until about this many bytes of text have
+        // been read into it, which saves the node allocations of many small files; names and values too long for the
+        // small string buffer are still allocated from the heap. Documents that share an arena must not be modified from
+        // several threads at once, and the arena is only released with the last of them.
+        std::size_t shared_arena_size = 0;
+    };
+
+    /**
+     * @brief A file loaded by @c load_many.
+     */
+    struct load_result {
+        // the sections read before an error, if any
+        ini document;
+
+        // why the file could not be loaded, or null: a @c std::system_error if it could not be read, a @c parser_exception
+        // if it could not be parsed
+        std::exception_ptr error;
+
+        /**
+         * @brief Whether the file was loaded without errors
+         */
+        inline explicit operator bool() const noexcept { return !error; }
+
+        /**
+         * @brief Rethrows the error of this file, if any.
+         */
+        inline void rethrow() const {
+            if (error) std::rethrow_exception(error);
+        }
+    };
+
+    /**
+     * @brief Reads and parses the files at @p paths on the workers of @p pool and returns them in the same order. A file
+     * that cannot be read or parsed does not stop the others; its error is returned with it. The calling thread loads
+     * files as well, so this may be called from a task of @p pool. Small files are read into a reused buffer rather than
+     * memory mapped.
+     * @param paths Paths of the files to load
+     * @param pool Threads to load on
+     * @param options Syntax of the files and arena sharing
+     * @return One result per path
+     */
+    INICPP std::vector<load_result> load_many(const std::vector<std::string>& paths, thread_pool& pool,
+        const load_options& options = load_options());
+}
+
+#endif
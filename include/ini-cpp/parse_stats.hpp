@@ -0,0 +1,42 @@
+#ifndef INICPP_PARSE_STATS_H
+#define INICPP_PARSE_STATS_H 1
+
+#include "config.h"
+
+#include <chrono>
+#include <cstddef>
+
+namespace inicpp {
+    /**
+     * @brief What a single read or reload of an @c ini did and where its time went. Passed to the overloads of
+     * @c ini::read, @c ini::read_file and @c ini::reload that take one, which reset it first; the other overloads do not
+     * collect anything.
+     *
+     * Collecting stats reads the clock around every section and key that is stored, so a read with stats is slower than
+     * one without, and the insert time includes the cost of the clock. Each phase is timed on its own, so together they
+     * fall short of the total by whatever ran in between, such as reading a stream or setting up the read.
+     */
+    struct parse_stats {
+        std::size_t bytes = 0;                  // bytes tokenized
+        std::size_t lines = 0;                  // lines tokenized
+        std::size_t comments = 0;               // comments skipped, whole lines and trailing ones
+        std::size_t sections_created = 0;       // headers that created a section
+        std::size_t sections_reopened = 0;      // headers of a section that already existed, whose keys were merged into it
+        std::size_t sections_unchanged = 0;     // sections that a reload kept without parsing them again
+        std::size_t keys_created = 0;           // keys added to a section
+        std::size_t keys_overwritten = 0;       // keys whose existing value was replaced
+
+        // Allocations made through the memory resource of the ini, for the nodes and tables of its sections and keys.
+        // Only counted if the ini allocates from a @c counting_resource. Names and values are @c std::string and allocate
+        // from the heap when they outgrow the small string buffer, which is not counted here.
+        std::size_t resource_allocations = 0;
+        std::size_t resource_bytes = 0;
+
+        std::chrono::nanoseconds prepare_time{};    // dropping temporary sections on read; splitting and hashing on reload
+        std::chrono::nanoseconds tokenize_time{};   // in the tokenizer, less the insert time of the tokens it handed on
+        std::chrono::nanoseconds insert_time{};     // storing sections and keys, and moving reloaded sections into place
+        std::chrono::nanoseconds total_time{};
+    };
+}
+
+#endif
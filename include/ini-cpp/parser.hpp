@@ -0,0 +1,105 @@
+#ifndef INICPP_PARSER_H
+#define INICPP_PARSER_H 1
+
+#include "config.h"
+#include "parser_exception.hpp"
+
+#include <cstddef>
+#include <istream>
+#include <string>
+#include <string_view>
+#include <unordered_set>
+
+namespace inicpp {
+    /**
+     * @brief Syntax settings of the tokenizer, the same ones an @c ini carries in its comment handles and delimiter.
+     */
+    struct parse_options {
+        std::unordered_set<std::string> comment_handles = { "//", "#", ";" };
+        std::string delimiter = "=";
+    };
+
+    /**
+     * @brief What was wrong with a line that could not be tokenized.
+     */
+    enum class parse_error_code {
+        unclosed_header,        // a section header without its ']'
+        empty_section_name,     // a section header with nothing but whitespace between the brackets
+        unexpected_character,   // text after a section header, or before the first one, that is not a comment
+        missing_delimiter       // a key line without the delimiter
+    };
+
+    /**
+     * @brief A line that could not be tokenized. Lines and columns are numbered from 1. The span covers the offending part
+     * of the line, in bytes from the start of the text that was read; for streams, from where reading started.
+     * The message is a static string, so errors can be stored and formatted later with @c to_string.
+     */
+    struct parse_error {
+        std::size_t line;
+        std::size_t column;
+        std::string_view message;
+        parse_error_code code;
+        std::size_t offset;
+        std::size_t length;
+    };
+
+    /**
+     * @brief Formats @p error as "line:column message", the message of the @c parser_exception thrown for it.
+     */
+    INICPP std::string to_string(const parse_error& error);
+
+    /**
+     * @brief Receives the tokens of an INI source, in order. The views passed to the handler point into the source (or into
+     * the read buffer, for streams) and are only valid for the duration of the call.
+     */
+    class parse_handler {
+    public:
+        virtual ~parse_handler() = default;
+
+        /**
+         * @brief Called for every section header, with the trimmed section name.
+         */
+        virtual void on_section(std::string_view name) { (void)name; }
+
+        /**
+         * @brief Called for every key of the current section, with the trimmed key and value.
+         */
+        virtual void on_key_value(std::string_view key, std::string_view value) { (void)key; (void)value; }
+
+        /**
+         * @brief Called for every comment, from its comment handle up to the end of the line, without trailing whitespace.
+         */
+        virtual void on_comment(std::string_view comment) { (void)comment; }
+
+        /**
+         * @brief Called for a line that cannot be tokenized. If this returns, the rest of the line is skipped and parsing
+         * goes on with the next line. After a malformed section header, only comments are reported up to the next valid
+         * header; keys are dropped unchecked. By default a @c parser_exception is thrown, with the same message
+         * @c ini::read throws.
+         */
+        INICPP virtual void on_error(const parse_error& error);
+    };
+
+    /**
+     * @brief Tokenizes @p source and hands every section, key and comment to @p handler, without building an @c ini.
+     * Apart from the handler itself the parser uses a constant amount of memory, so it suits tools that only scan large files.
+     * @param source The INI text
+     * @param handler Receiver of the tokens
+     * @param options Comment handles and delimiter
+     */
+    INICPP void parse(std::string_view source, parse_handler& handler, const parse_options& options = parse_options());
+
+    /**
+     * @brief Tokenizes the rest of @p in, see @c parse. The stream is read in chunks, so memory use is bounded by the
+     * longest line rather than the size of the input. If a @c parser_exception escapes, the failbit of @p in is set.
+     */
+    INICPP void parse(std::istream& in, parse_handler& handler, const parse_options& options = parse_options());
+
+    /**
+     * @brief Tokenizes the file at @p path, see @c parse. The file is memory mapped rather than read.
+     * If the file cannot be opened, an exception of type @c std::system_error is thrown.
+     */
+    INICPP void parse_file(const std::string& path, parse_handler& handler, const parse_options& options = parse_options());
+}
+
+#endif
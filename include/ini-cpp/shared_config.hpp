@@ -0,0 +1,125 @@
+#ifndef INICPP_SHARED_CONFIG_H
+#define INICPP_SHARED_CONFIG_H 1
+
+#include "config.h"
+#include "ini.hpp"
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <string>
+
+namespace inicpp {
+    /**
+     * @brief Publishes fully parsed, immutable @c ini snapshots to concurrent readers. A new configuration is parsed off
+     * to the side and swapped in with @c std::atomic_exchange on the snapshot pointer; readers keep the snapshot they
+     * pinned until they let go of it, and a snapshot is destroyed when its last reader drops it.
+     *
+     * Worker threads read through a @c shared_config::reader, created with @c make_reader. While the configuration is
+     * unchanged, @c reader::get is a single wait-free atomic load of the version and touches neither the snapshot pointer
+     * nor its reference count; a reader pins the new snapshot once per publish.
+     *
+     * Pinning, whether by a reader after a publish or by a direct call to @c load, is not lock-free: the atomic functions
+     * for @c std::shared_ptr are implemented with an internal lock in common standard libraries (libstdc++ uses a small
+     * pool of mutexes), so concurrent calls to @c load and @c publish contend with each other. Call @c load directly only
+     * where a snapshot is pinned rarely, such as at startup or in the writer.
+     */
+    class shared_config {
+    public:
+        typedef std::shared_ptr<const ini> snapshot;
+
+        class reader;
+    public:
+        /**
+         * @brief Constructs a shared_config that publishes an empty ini.
+         */
+        INICPP shared_config();
+
+        /**
+         * @brief Constructs a shared_config that publishes @p initial.
+         */
+        INICPP explicit shared_config(ini initial);
+
+        shared_config(const shared_config&) = delete;
+        shared_config& operator=(const shared_config&) = delete;
+
+        /**
+         * @brief Pins the current snapshot. The snapshot stays valid for as long as the returned pointer is held, even if
+         * newer snapshots are published in the meantime. This takes the lock of the atomic shared_ptr functions, so threads
+         * that read the configuration repeatedly should use a @c reader instead.
+         * @return The current snapshot, never null
+         */
+        INICPP snapshot load() const noexcept;
+
+        /**
+         * @brief Publishes a new snapshot. Readers that pin a snapshot afterwards see @p next.
+         * @param next The configuration to publish
+         */
+        INICPP void publish(ini next);
+
+        /**
+         * @brief Publishes an existing snapshot. If @p next is null, an empty ini is published instead.
+         * @param next The snapshot to publish
+         */
+        INICPP void publish(snapshot next);
+
+        /**
+         * @brief Parses the file at @p path into a new ini, using the comment handles and delimiter of the current snapshot,
+         * and publishes it. If the file cannot be read or parsed, the exception is propagated and the current snapshot stays published.
+         * The file is read into a buffer rather than memory mapped, so another process may rewrite it in place meanwhile.
+         * @param path Path of the file to read
+         */
+        INICPP void read_file(const std::string& path);
+
+        /**
+         * @brief Retrieves the number of snapshots published so far, including the initial one.
+         */
+        inline std::uint64_t version() const noexcept { return m_version.load(std::memory_order_acquire); }
+
+        /**
+         * @brief Creates a reader that caches the current snapshot, the way for a thread to read the configuration repeatedly.
+         */
+        inline reader make_reader() const;
+    private:
+        // only accessed through std::atomic_load_explicit and std::atomic_exchange_explicit
+        snapshot m_current;
+        std::atomic<std::uint64_t> m_version{ 0 };
+    };
+
+    /**
+     * @brief Per-thread view of a @c shared_config. It keeps the last snapshot it has seen pinned, and only reloads it when
+     * the version of the shared_config has changed, so reading an unchanged configuration costs one wait-free atomic load
+     * and only the first call after a publish takes the lock of @c shared_config::load.
+     * A reader must not be shared between threads, and must not outlive its @c shared_config.
+     */
+    class shared_config::reader {
+    public:
+        inline explicit reader(const shared_config& config) : m_config(&config) { refresh(); }
+
+        /**
+         * @brief Retrieves the latest snapshot, reloading it if a newer one has been published since the last call.
+         * @return The current snapshot, never null
+         */
+        inline const snapshot& get() {
+            if (m_config->version() != m_version) refresh();
+            return m_snapshot;
+        }
+
+        inline const ini& operator*() { return *get(); }
+        inline const ini* operator->() { return get().get(); }
+    private:
+        inline void refresh() {
+            // the version is read first: a snapshot published in between is picked up again by the next call
+            m_version = m_config->version();
+            m_snapshot = m_config->load();
+        }
+
+        const shared_config* m_config;
+        snapshot m_snapshot;
+        std::uint64_t m_version = 0;
+    };
+
+    inline shared_config::reader shared_config::make_reader() const { return reader(*this); }
+}
+
+#endif
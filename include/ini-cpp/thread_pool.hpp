@@ -0,0 +1,78 @@
+#ifndef INICPP_THREAD_POOL_H
+#define INICPP_THREAD_POOL_H 1
+
+#include "config.h"
+
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace inicpp {
+    /**
+     * @brief Fixed set of worker threads that run submitted tasks in submission order. Used by @c ini::read_parallel and
+     * @c load_many, and may be shared with the rest of an application.
+     */
+    class thread_pool {
+    public:
+        /**
+         * @brief Starts @p threads workers, or one per hardware thread if @p threads is 0.
+         */
+        INICPP explicit thread_pool(std::size_t threads = 0);
+
+        thread_pool(const thread_pool&) = delete;
+        thread_pool& operator=(const thread_pool&) = delete;
+
+        /**
+         * @brief Runs the tasks that are still queued, then stops the workers.
+         */
+        INICPP ~thread_pool();
+
+        /**
+         * @brief Retrieves the number of worker threads.
+         */
+        inline std::size_t size() const noexcept { return m_workers.size(); }
+
+        /**
+         * @brief Queues @p f to run on a worker.
+         * @return Future that receives the result of @p f, or the exception it threw
+         */
+        template<typename F>
+        inline std::future<std::invoke_result_t<std::decay_t<F>>> submit(F&& f) {
+            // std::function has to be copyable, so the move-only task is held through a shared_ptr
+            auto task = std::make_shared<std::packaged_task<std::invoke_result_t<std::decay_t<F>>()>>(std::forward<F>(f));
+            auto result = task->get_future();
+            push([task] { (*task)(); });
+            return result;
+        }
+
+        /**
+         * @brief Calls @p job once for every index in [0, @p count) on the workers and on the calling thread, and returns
+         * when all calls have finished. Indices are handed out in increasing order. Since the calling thread takes part,
+         * this may be called from a task of the same pool. If @p job throws, the remaining indices are still run and the
+         * first exception is rethrown.
+         * @param count Number of indices
+         * @param job Function to call with each index
+         */
+        INICPP void run_indexed(std::size_t count, std::function<void(std::size_t)> job);
+    private:
+        INICPP void push(std::function<void()> task);
+        void run();
+
+        std::mutex m_mutex;
+        std::condition_variable m_wake;
+        std::deque<std::function<void()>> m_tasks;
+        bool m_stopping = false;
+
+        std::vector<std::thread> m_workers;
+    };
+}
+
+#endif
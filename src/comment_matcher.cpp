@@ -0,0 +1,48 @@
+#include "comment_matcher.h"
+
+namespace inicpp::detail {
+    void comment_matcher::add(std::string_view handle) {
+        if (handle.empty()) return;
+
+        unsigned char const first = static_cast<unsigned char>(handle[0]);
+        if (m_root[first] < 0) {
+            m_root[first] = static_cast<std::int32_t>(m_nodes.size());
+            m_nodes.push_back({ -1, -1, first, false });
+            m_first_bytes += handle[0];
+        }
+
+        std::int32_t cur = m_root[first];
+        for (std::size_t i = 1; i < handle.length(); i++) {
+            unsigned char const byte = static_cast<unsigned char>(handle[i]);
+
+            std::int32_t child = m_nodes[cur].first_child;
+            for (; child >= 0 && m_nodes[child].byte != byte; child = m_nodes[child].next_sibling);
+            if (child < 0) {
+                child = static_cast<std::int32_t>(m_nodes.size());
+                m_nodes.push_back({ -1, m_nodes[cur].first_child, byte, false });
+                m_nodes[cur].first_child = child;
+            }
+            cur = child;
+        }
+        m_nodes[cur].terminal = true;
+    }
+
+    bool comment_matcher::match(const char* pos, const char* const end) const noexcept {
+        if (pos == end) return false;
+
+        std::int32_t cur = m_root[static_cast<unsigned char>(*pos)];
+        if (cur < 0) return false;
+
+        // any handle that is a prefix of the input is a match, so the walk stops at the first terminal node
+        for (++pos; !m_nodes[cur].terminal; ++pos) {
+            if (pos == end) return false;
+
+            unsigned char const byte = static_cast<unsigned char>(*pos);
+            std::int32_t child = m_nodes[cur].first_child;
+            for (; child >= 0 && m_nodes[child].byte != byte; child = m_nodes[child].next_sibling);
+            if (child < 0) return false;
+            cur = child;
+        }
+        return true;
+    }
+}
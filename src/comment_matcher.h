@@ -0,0 +1,57 @@
+#ifndef INICPP_COMMENT_MATCHER_H
+#define INICPP_COMMENT_MATCHER_H 1
+
+#include <algorithm>
+#include <cstdint>
+#include <iterator>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace inicpp::detail {
+    /**
+     * @brief Comment handles compiled into a first-byte table and a small trie. Checking whether a comment starts at a
+     * position is one table load and a walk of at most the longest handle, no matter how many handles are registered.
+     */
+    class comment_matcher {
+    public:
+        /**
+         * @brief Compiles the given set of comment handles. Empty handles are ignored.
+         * @tparam Range Range of strings convertible to @c std::string_view
+         */
+        template<typename Range>
+        explicit comment_matcher(const Range& handles) {
+            std::fill(std::begin(m_root), std::end(m_root), -1);
+            for (auto const& handle : handles) add(handle);
+        }
+
+        /**
+         * @brief Checks whether any comment handle starts at @p pos.
+         * @param pos Position to check
+         * @param end End of the readable buffer
+         * @return True if a comment starts at @p pos, false otherwise
+         */
+        bool match(const char* pos, const char* end) const noexcept;
+
+        /**
+         * @brief Retrieves the distinct first bytes of all handles, used to seed the structural byte scanner.
+         * @return The bytes that may start a comment
+         */
+        inline std::string const& first_bytes() const noexcept { return m_first_bytes; }
+    private:
+        struct node {
+            std::int32_t first_child = -1;
+            std::int32_t next_sibling = -1;
+            unsigned char byte = 0;
+            bool terminal = false;
+        };
+
+        void add(std::string_view handle);
+
+        std::int32_t m_root[256];
+        std::vector<node> m_nodes;
+        std::string m_first_bytes;
+    };
+}
+
+#endif
@@ -0,0 +1,267 @@
+#include "file_watcher.hpp"
+#include "mapped_file.h"
+#include "hash.h"
+
+#include <algorithm>
+#include <filesystem>
+#include <limits>
+#include <system_error>
+
+#ifdef __linux__
+#   include <poll.h>
+#   include <sys/eventfd.h>
+#   include <sys/inotify.h>
+#   include <unistd.h>
+#   include <cerrno>
+#   include <climits>
+#endif
+
+namespace inicpp {
+    namespace {
+        // What the poller compares before it bothers to read the file
+        struct file_stamp {
+            std::filesystem::file_time_type time;
+            std::uintmax_t size = 0;
+            bool exists = false;
+
+            inline bool operator==(const file_stamp& other) const noexcept { return exists == other.exists && size == other.size && time == other.time; }
+            inline bool operator!=(const file_stamp& other) const noexcept { return !operator==(other); }
+        };
+
+        file_stamp stamp(const std::string& path) noexcept {
+            std::error_code ec;
+            file_stamp result;
+            result.time = std::filesystem::last_write_time(path, ec);
+            if (ec) return file_stamp();
+            result.size = std::filesystem::file_size(path, ec);
+            result.exists = !ec;
+            return result;
+        }
+    }
+
+    INICPP file_watcher::file_watcher(std::string path, watch_options options) : file_watcher(std::move(path), ini(), options) {}
+
+    INICPP file_watcher::file_watcher(std::string path, ini prototype, watch_options options)
+        : m_path(std::move(path)), m_options(options) {
+#ifdef __linux__
+        // the watch is set up before the initial read, so that a change made in between is not missed
+        if (!m_options.force_polling) open_notifications();
+#endif
+        try {
+            read_text();
+            prototype.read_buffer(m_text);
+        } catch (...) {
+            close_notifications();
+            throw;
+        }
+        m_parse_count++;
+        m_size = m_text.length();
+        m_hash = detail::hash_bytes(m_text);
+        m_config.publish(std::move(prototype));
+
+        if (m_notify_fd >= 0) m_thread = std::thread([this] { run_inotify(); });
+        else m_thread = std::thread([this] { run_polling(); });
+    }
+
+    INICPP file_watcher::~file_watcher() {
+        {
+            std::lock_guard<std::mutex> lock(m_stop_mutex);
+            m_stopping = true;
+        }
+        m_stop_signal.notify_all();
+#ifdef __linux__
+        if (m_wake_fd >= 0) {
+            std::uint64_t const one = 1;
+            [[maybe_unused]] auto const written = ::write(m_wake_fd, &one, sizeof(one));
+        }
+#endif
+        if (m_thread.joinable()) m_thread.join();
+        close_notifications();
+    }
+
+#ifdef __linux__
+    void file_watcher::open_notifications() {
+        // the directory is watched rather than the file, so that editors and deployment tools that replace the file
+        // through a rename are followed as well
+        std::filesystem::path const path(m_path);
+        std::string const directory = path.has_parent_path() ? path.parent_path().string() : std::string(".");
+
+        m_wake_fd = ::eventfd(0, EFD_CLOEXEC | EFD_NONBLOCK);
+        m_notify_fd = m_wake_fd >= 0 ? ::inotify_init1(IN_NONBLOCK | IN_CLOEXEC) : -1;
+        if (m_notify_fd < 0 || ::inotify_add_watch(m_notify_fd, directory.c_str(),
+            IN_CLOSE_WRITE | IN_MODIFY | IN_MOVED_TO | IN_CREATE | IN_DELETE | IN_MOVED_FROM) < 0)
+            close_notifications();
+    }
+
+    void file_watcher::close_notifications() noexcept {
+        if (m_notify_fd >= 0) ::close(m_notify_fd);
+        if (m_wake_fd >= 0) ::close(m_wake_fd);
+        m_notify_fd = m_wake_fd = -1;
+    }
+#else
+    void file_watcher::close_notifications() noexcept {}
+#endif
+
+    INICPP file_watcher::subscription file_watcher::subscribe(callback f) {
+        std::lock_guard<std::mutex> lock(m_subscriber_mutex);
+        m_subscribers.emplace_back(++m_next_subscription, std::move(f));
+        return m_next_subscription;
+    }
+
+    INICPP void file_watcher::unsubscribe(subscription id) {
+        std::lock_guard<std::mutex> lock(m_subscriber_mutex);
+        m_subscribers.erase(std::remove_if(m_subscribers.begin(), m_subscribers.end(), [id](auto const& s) { return s.first == id; }), m_subscribers.end());
+    }
+
+    INICPP void file_watcher::set_error_handler(error_handler f) {
+        std::lock_guard<std::mutex> lock(m_subscriber_mutex);
+        m_error_handler = std::move(f);
+    }
+
+    void file_watcher::report(std::exception_ptr error) {
+        error_handler handler;
+        {
+            std::lock_guard<std::mutex> lock(m_subscriber_mutex);
+            handler = m_error_handler;
+        }
+        if (handler) handler(error);
+    }
+
+    void file_watcher::read_text() {
+        // The file is copied rather than mapped: it is rewritten by other processes, and one that truncates it in place
+        // would turn a read of the mapping into SIGBUS. A file that shrinks while it is read just ends early.
+        detail::read_small_file(m_path, m_text, std::numeric_limits<std::size_t>::max());
+    }
+
+    INICPP bool file_watcher::check() {
+        shared_config::snapshot published;
+        std::uint64_t version = 0;
+        try {
+            std::lock_guard<std::mutex> lock(m_check_mutex);
+
+            read_text();
+            std::uint64_t const hash = detail::hash_bytes(m_text);
+            if (m_text.length() == m_size && hash == m_hash) return false;
+
+            auto const current = m_config.load();
+            ini next;
+            next.get_comment_handles() = current->get_comment_handles();
+            next.set_delimeter(current->get_delimeter());
+
+            // remembered up front, so that a version that fails to parse is not parsed again until it changes
+            m_size = m_text.length();
+            m_hash = hash;
+            m_parse_count++;
+            next.read_buffer(m_text);
+
+            published = std::make_shared<const ini>(std::move(next));
+            m_config.publish(published);
+            version = ++m_version;
+        } catch (...) {
+            report(std::current_exception());
+            return false;
+        }
+
+        // Concurrent checks notify one at a time, and a version that lost the race to a newer one is dropped, so subscribers
+        // see versions in the order they were published. Only m_notify_mutex is held, so they may subscribe or unsubscribe
+        // themselves.
+        std::lock_guard<std::mutex> notify_lock(m_notify_mutex);
+        if (version <= m_notified_version) return true;
+        m_notified_version = version;
+
+        std::vector<std::pair<subscription, callback>> subscribers;
+        {
+            std::lock_guard<std::mutex> lock(m_subscriber_mutex);
+            subscribers = m_subscribers;
+        }
+        for (auto const& subscriber : subscribers) {
+            try {
+                subscriber.second(published);
+            } catch (...) {
+                report(std::current_exception());
+            }
+        }
+        return true;
+    }
+
+    void file_watcher::settle_and_check() {
+        // without notifications, the file is considered settled once its stamp stops changing for the debounce interval
+        file_stamp last = stamp(m_path);
+        for (;;) {
+            {
+                std::unique_lock<std::mutex> lock(m_stop_mutex);
+                if (m_stop_signal.wait_for(lock, m_options.debounce, [this] { return m_stopping; })) return;
+            }
+            file_stamp const now = stamp(m_path);
+            if (now == last) break;
+            last = now;
+        }
+        check();
+    }
+
+    void file_watcher::run_polling() {
+        // unknown at first, so that the first poll catches a change made since the initial read
+        file_stamp last;
+        for (;;) {
+            {
+                std::unique_lock<std::mutex> lock(m_stop_mutex);
+                if (m_stop_signal.wait_for(lock, m_options.poll_interval, [this] { return m_stopping; })) return;
+            }
+
+            file_stamp const now = stamp(m_path);
+            if (now == last) continue;
+            settle_and_check();
+            last = stamp(m_path);
+        }
+    }
+
+#ifdef __linux__
+    void file_watcher::run_inotify() {
+        int const fd = m_notify_fd;
+        std::string const name = std::filesystem::path(m_path).filename().string();
+
+        // Drains the pending events, telling whether any of them concerns the watched file
+        auto const drain = [fd, &name] {
+            alignas(inotify_event) char buffer[4096];
+            bool relevant = false;
+            for (;;) {
+                ssize_t const length = ::read(fd, buffer, sizeof(buffer));
+                if (length <= 0) break;
+                for (ssize_t offset = 0; offset < length;) {
+                    auto const event = reinterpret_cast<const inotify_event*>(buffer + offset);
+                    if ((event->mask & IN_Q_OVERFLOW) || (event->len > 0 && name == event->name)) relevant = true;
+                    offset += sizeof(inotify_event) + event->len;
+                }
+            }
+            return relevant;
+        };
+
+        // Waits for an event or a stop request. Returns 0 on timeout, 1 on events and -1 when stopping
+        auto const wait = [this, fd](int timeout) {
+            pollfd fds[2] = { { fd, POLLIN, 0 }, { m_wake_fd, POLLIN, 0 } };
+            for (;;) {
+                int const ready = ::poll(fds, 2, timeout);
+                if (ready < 0 && errno == EINTR) continue;
+                if (ready < 0 || (fds[1].revents & POLLIN)) return -1;
+                return ready == 0 ? 0 : 1;
+            }
+        };
+
+        int const debounce = static_cast<int>(std::min<std::chrono::milliseconds::rep>(m_options.debounce.count(), INT_MAX));
+        for (;;) {
+            int const event = wait(-1);
+            if (event < 0) break;
+            if (!drain()) continue;
+
+            // keep absorbing events until the file has been quiet for the debounce interval
+            int settled;
+            while ((settled = wait(debounce)) > 0) drain();
+            if (settled < 0) break;
+
+            check();
+        }
+    }
+#else
+    void file_watcher::run_inotify() { run_polling(); }
+#endif
+}
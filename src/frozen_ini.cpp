@@ -0,0 +1,367 @@
+#include "frozen_ini.hpp"
+#include "ini.hpp"
+#include "hash.h"
+#include "mapped_file.h"
+#include "replace_file.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstring>
+#include <limits>
+#include <numeric>
+#include <stdexcept>
+#include <vector>
+
+namespace inicpp {
+    namespace {
+        constexpr std::uint64_t seed_multiplier = 0x9e3779b97f4a7c15ull;
+
+        inline std::uint64_t name_hash(std::string_view name, std::uint32_t salt) noexcept { return detail::hash_bytes(name, salt); }
+
+        // maps a 32-bit number onto [0, n) with a multiplication instead of a division
+        inline std::uint32_t reduce(std::uint32_t x, std::uint32_t n) noexcept { return static_cast<std::uint32_t>((std::uint64_t(x) * n) >> 32); }
+
+        inline std::uint32_t bucket_of(std::uint64_t hash, std::uint32_t bucket_count) noexcept { return reduce(static_cast<std::uint32_t>(hash), bucket_count); }
+
+        inline std::uint32_t slot_of(std::uint64_t hash, std::uint32_t seed, std::uint32_t slot_count) noexcept {
+            return reduce(static_cast<std::uint32_t>(((hash ^ (seed * seed_multiplier)) * seed_multiplier) >> 32), slot_count);
+        }
+
+        // Probes a table built by build_table, returning the index of the only candidate entry
+        inline std::uint32_t probe(const char* base, const detail::frozen_table& table, std::uint64_t hash) noexcept {
+            if (table.slot_count == 0) return detail::frozen_table::empty;
+            auto const seeds = reinterpret_cast<const std::uint32_t*>(base + table.seeds);
+            auto const slots = reinterpret_cast<const std::uint32_t*>(base + table.slots);
+            return slots[slot_of(hash, seeds[bucket_of(hash, table.bucket_count)], table.slot_count)];
+        }
+
+        inline bool name_equals(const char* base, std::uint32_t name, std::uint32_t length, std::string_view other) noexcept {
+            return length == other.size() && std::memcmp(base + name, other.data(), length) == 0;
+        }
+
+        /*
+         * Hash and displace: entries are grouped into buckets of about two, and the buckets are placed largest first.
+         * Each bucket tries seeds until all of its entries land on free, distinct slots. Returns false if a bucket
+         * could not be placed, in which case the caller retries with a different salt.
+         */
+        bool build_table(const std::vector<std::uint64_t>& hashes, std::vector<std::uint32_t>& seeds, std::vector<std::uint32_t>& slots) {
+            constexpr std::uint32_t max_attempts = 1u << 16;
+
+            auto const count = static_cast<std::uint32_t>(hashes.size());
+            std::uint32_t const bucket_count = count / 2 + 1;
+            std::uint32_t const slot_count = count + count / 4 + 1;
+
+            // counting sort of the entries by bucket
+            std::vector<std::uint32_t> bucket_start(bucket_count + 1, 0);
+            for (auto hash : hashes) bucket_start[bucket_of(hash, bucket_count) + 1]++;
+            std::partial_sum(bucket_start.begin(), bucket_start.end(), bucket_start.begin());
+
+            std::vector<std::uint32_t> members(count);
+            {
+                std::vector<std::uint32_t> fill(bucket_start.begin(), bucket_start.end() - 1);
+                for (std::uint32_t i = 0; i < count; i++) members[fill[bucket_of(hashes[i], bucket_count)]++] = i;
+            }
+
+            std::vector<std::uint32_t> order(bucket_count);
+            std::iota(order.begin(), order.end(), 0);
+            std::stable_sort(order.begin(), order.end(), [&](std::uint32_t a, std::uint32_t b) {
+                return bucket_start[a + 1] - bucket_start[a] > bucket_start[b + 1] - bucket_start[b];
+            });
+
+            seeds.assign(bucket_count, 0);
+            slots.assign(slot_count, detail::frozen_table::empty);
+
+            std::vector<std::uint32_t> placed;
+            for (auto bucket : order) {
+                std::uint32_t const first = bucket_start[bucket], last = bucket_start[bucket + 1];
+                if (first == last) break;
+
+                std::uint32_t seed = 0;
+                for (;; seed++) {
+                    if (seed == max_attempts) return false;
+
+                    placed.clear();
+                    bool fits = true;
+                    for (std::uint32_t i = first; i < last && fits; i++) {
+                        std::uint32_t const slot = slot_of(hashes[members[i]], seed, slot_count);
+                        fits = slots[slot] == detail::frozen_table::empty && std::find(placed.begin(), placed.end(), slot) == placed.end();
+                        placed.push_back(slot);
+                    }
+                    if (fits) break;
+                }
+
+                seeds[bucket] = seed;
+                for (std::uint32_t i = first; i < last; i++) slots[placed[i - first]] = members[i];
+            }
+
+            return true;
+        }
+
+        // Appends raw bytes to the blob, returning their offset
+        template<typename T>
+        std::uint32_t append(std::vector<char>& blob, const T* data, std::size_t count) {
+            std::size_t const offset = blob.size();
+            std::size_t const bytes = count * sizeof(T);
+            if (offset + bytes > std::numeric_limits<std::uint32_t>::max()) throw std::length_error("ini::freeze");
+            blob.resize(offset + bytes);
+            if (bytes) std::memcpy(blob.data() + offset, data, bytes);
+            return static_cast<std::uint32_t>(offset);
+        }
+
+        constexpr char binary_magic[8] = { 'I', 'N', 'I', 'C', 'P', 'P', 'B', '\0' };
+
+        inline std::uint64_t header_checksum(const detail::frozen_file_header& header) noexcept {
+            return detail::hash_bytes(std::string_view(reinterpret_cast<const char*>(&header), offsetof(detail::frozen_file_header, header_checksum)));
+        }
+
+        // Whether count entries of type T at offset lie within a blob of size bytes and are aligned for T
+        template<typename T>
+        inline bool fits(std::uint64_t offset, std::uint64_t count, std::uint64_t size) noexcept {
+            return offset % alignof(T) == 0 && offset <= size && count <= (size - offset) / sizeof(T);
+        }
+
+        // Whether a string of the pool lies within the blob, including its NUL character
+        inline bool fits_string(const char* blob, std::uint64_t offset, std::uint64_t length, std::uint64_t size) noexcept {
+            return offset < size && length < size - offset && blob[offset + length] == '\0';
+        }
+
+        // Whether a table lies within the blob and every slot refers to one of its count entries
+        bool check_table(const char* blob, const detail::frozen_table& table, std::uint32_t count, std::uint64_t size) noexcept {
+            if (table.slot_count == 0) return true;
+            if (table.bucket_count == 0 || !fits<std::uint32_t>(table.seeds, table.bucket_count, size)
+                || !fits<std::uint32_t>(table.slots, table.slot_count, size))
+                return false;
+
+            auto const slots = reinterpret_cast<const std::uint32_t*>(blob + table.slots);
+            return std::all_of(slots, slots + table.slot_count, [count](std::uint32_t slot) { return slot == detail::frozen_table::empty || slot < count; });
+        }
+
+        // Whether every offset and length in the blob lies within it, so that a lookup never reads past the mapping
+        bool check_layout(const char* blob, std::uint64_t size) noexcept {
+            auto const& h = *reinterpret_cast<const detail::frozen_header*>(blob);
+            if (!fits<detail::frozen_section>(h.sections, h.section_count, size) || !fits<detail::frozen_key>(h.keys, h.key_count, size)
+                || h.strings > size || !check_table(blob, h.section_table, h.section_count, size))
+                return false;
+
+            auto const sections = reinterpret_cast<const detail::frozen_section*>(blob + h.sections);
+            for (std::uint32_t i = 0; i < h.section_count; i++) {
+                auto const& section = sections[i];
+                if (!fits_string(blob, section.name, section.name_length, size) || section.first_key > h.key_count
+                    || section.key_count > h.key_count - section.first_key || !check_table(blob, section.key_table, section.key_count, size))
+                    return false;
+            }
+
+            auto const keys = reinterpret_cast<const detail::frozen_key*>(blob + h.keys);
+            for (std::uint32_t i = 0; i < h.key_count; i++) {
+                if (!fits_string(blob, keys[i].name, keys[i].name_length, size) || !fits_string(blob, keys[i].value, keys[i].value_length, size))
+                    return false;
+            }
+            return true;
+        }
+
+        // Returns the blob of a compiled file and the hash it was compiled from, or null if this build cannot use the file
+        const char* check_binary(std::string_view file, std::uint64_t& source_hash) noexcept {
+            detail::frozen_file_header header;
+            if (file.size() < sizeof(header)) return nullptr;
+            std::memcpy(&header, file.data(), sizeof(header));
+
+            if (std::memcmp(header.magic, binary_magic, sizeof(binary_magic)) != 0 || header.version != detail::frozen_format_version
+                || header.layout != detail::frozen_layout_tag || header.header_checksum != header_checksum(header))
+                return nullptr;
+            if (header.size != file.size() - sizeof(header) || header.size < sizeof(detail::frozen_header)) return nullptr;
+
+            const char* const blob = file.data() + sizeof(header);
+            if (detail::hash_bytes(std::string_view(blob, header.size)) != header.checksum) return nullptr;
+            if (reinterpret_cast<const detail::frozen_header*>(blob)->size != header.size) return nullptr;
+            if (!check_layout(blob, header.size)) return nullptr;
+
+            source_hash = header.source_hash;
+            return blob;
+        }
+    }
+
+    INICPP frozen_ini frozen_ini::build(const ini& source) {
+        std::vector<detail::frozen_section> sections;
+        std::vector<detail::frozen_key> keys;
+        std::vector<std::string_view> section_names, key_names;
+        std::vector<char> strings;
+
+        auto const intern = [&strings](std::string_view s) {
+            if (strings.size() + s.size() + 1 > std::numeric_limits<std::uint32_t>::max()) throw std::length_error("ini::freeze");
+            auto const offset = static_cast<std::uint32_t>(strings.size());
+            strings.insert(strings.end(), s.begin(), s.end());
+            strings.push_back('\0');
+            return offset;
+        };
+
+        for (auto const& sec : source) {
+            detail::frozen_section entry{ intern(sec.get_name()), static_cast<std::uint32_t>(sec.get_name().size()), static_cast<std::uint32_t>(keys.size()), 0, {} };
+            for (auto const& kv : sec) {
+                std::string_view const value = kv.second.get_value();
+                auto const name = intern(kv.first);
+                keys.push_back({ name, static_cast<std::uint32_t>(kv.first.size()), intern(value), static_cast<std::uint32_t>(value.size()) });
+                key_names.push_back(kv.first);
+                entry.key_count++;
+            }
+            sections.push_back(entry);
+            section_names.push_back(sec.get_name());
+        }
+
+        // all seeds and slots go into one array, and a new salt is drawn until every table could be built,
+        // which almost always succeeds at once
+        detail::frozen_header header{};
+        std::vector<std::uint32_t> tables, seeds, slots;
+        std::vector<std::uint64_t> hashes;
+
+        auto const add_table = [&](detail::frozen_table& table) {
+            if (!build_table(hashes, seeds, slots)) return false;
+            table = { static_cast<std::uint32_t>(seeds.size()), static_cast<std::uint32_t>(tables.size()), static_cast<std::uint32_t>(slots.size()),
+                static_cast<std::uint32_t>(tables.size() + seeds.size()) };
+            tables.insert(tables.end(), seeds.begin(), seeds.end());
+            tables.insert(tables.end(), slots.begin(), slots.end());
+            return true;
+        };
+
+        for (std::uint32_t attempt = 0;; attempt++) {
+            header.salt = static_cast<std::uint32_t>(detail::mix(attempt));
+            tables.clear();
+
+            hashes.clear();
+            for (auto name : section_names) hashes.push_back(name_hash(name, header.salt));
+            bool built = add_table(header.section_table);
+
+            for (auto& entry : sections) {
+                if (!built) break;
+                entry.key_table = {};
+                if (entry.key_count == 0) continue;
+
+                hashes.clear();
+                for (std::uint32_t k = entry.first_key; k < entry.first_key + entry.key_count; k++) hashes.push_back(name_hash(key_names[k], header.salt));
+                built = add_table(entry.key_table);
+            }
+
+            if (built) break;
+        }
+
+        // the tables and the pool go last, so the offsets collected above are shifted by everything in front of them
+        std::size_t const tables_offset = sizeof(detail::frozen_header) + sections.size() * sizeof(detail::frozen_section) + keys.size() * sizeof(detail::frozen_key);
+        std::size_t const strings_offset = tables_offset + tables.size() * sizeof(std::uint32_t);
+        if (strings_offset + strings.size() > std::numeric_limits<std::uint32_t>::max()) throw std::length_error("ini::freeze");
+
+        auto const relocate = [tables_offset](detail::frozen_table& table) {
+            table.seeds = static_cast<std::uint32_t>(tables_offset + table.seeds * sizeof(std::uint32_t));
+            table.slots = static_cast<std::uint32_t>(tables_offset + table.slots * sizeof(std::uint32_t));
+        };
+
+        relocate(header.section_table);
+        for (auto& entry : sections) {
+            entry.name += static_cast<std::uint32_t>(strings_offset);
+            relocate(entry.key_table);
+        }
+        for (auto& entry : keys) {
+            entry.name += static_cast<std::uint32_t>(strings_offset);
+            entry.value += static_cast<std::uint32_t>(strings_offset);
+        }
+
+        std::vector<char> blob(sizeof(detail::frozen_header));
+        blob.reserve(strings_offset + strings.size());
+        header.section_count = static_cast<std::uint32_t>(sections.size());
+        header.key_count = static_cast<std::uint32_t>(keys.size());
+        header.sections = append(blob, sections.data(), sections.size());
+        header.keys = append(blob, keys.data(), keys.size());
+        append(blob, tables.data(), tables.size());
+        header.strings = append(blob, strings.data(), strings.size());
+        header.size = static_cast<std::uint32_t>(blob.size());
+        std::memcpy(blob.data(), &header, sizeof(header));
+
+        // operator new[] returns storage aligned for every fundamental type, which the uint32_t tables rely on
+        std::shared_ptr<char[]> storage(new char[blob.size()]);
+        std::memcpy(storage.get(), blob.data(), blob.size());
+        const char* const base = storage.get();
+        return frozen_ini(std::shared_ptr<const void>(std::move(storage), base), base);
+    }
+
+    INICPP void frozen_ini::save_binary(const std::string& path, const std::uint64_t source_hash) const {
+        if (!m_base) return build(ini()).save_binary(path, source_hash);
+
+        detail::frozen_file_header header{};
+        std::memcpy(header.magic, binary_magic, sizeof(binary_magic));
+        header.version = detail::frozen_format_version;
+        header.layout = detail::frozen_layout_tag;
+        header.source_hash = source_hash;
+        header.size = storage_size();
+        header.checksum = detail::hash_bytes(std::string_view(m_base, storage_size()));
+        header.header_checksum = header_checksum(header);
+
+        std::string file(sizeof(header) + storage_size(), '\0');
+        std::memcpy(file.data(), &header, sizeof(header));
+        std::memcpy(file.data() + sizeof(header), m_base, storage_size());
+        detail::replace_file(path, file);
+    }
+
+    INICPP frozen_ini frozen_ini::map_binary(const std::string& path, const std::uint64_t* const source_hash) {
+        auto file = std::make_shared<detail::mapped_file>(path);
+
+        // the header is a multiple of eight bytes long and the mapping starts on a page, so the blob is aligned for its tables
+        std::uint64_t compiled_from = 0;
+        const char* const blob = check_binary(file->view(), compiled_from);
+        if (!blob || (source_hash && *source_hash != compiled_from)) return frozen_ini();
+        return frozen_ini(std::shared_ptr<const void>(std::move(file), blob), blob);
+    }
+
+    INICPP frozen_ini frozen_ini::load_binary(const std::string& path) {
+        frozen_ini result = map_binary(path, nullptr);
+        if (!result.m_base) throw parser_exception("load_binary: " + path + " is not a compiled ini of this version");
+        return result;
+    }
+
+    INICPP frozen_ini frozen_ini::read_file_cached(const std::string& path, const std::string& cache_path, const parse_options& options) {
+        detail::mapped_file source(path);
+        std::uint64_t const source_hash = detail::hash_bytes(source.view(), detail::settings_seed(options.comment_handles, options.delimiter));
+
+        try {
+            frozen_ini cached = map_binary(cache_path, &source_hash);
+            if (cached.m_base) return cached;
+        } catch (const std::system_error&) {
+            // there is no cache yet
+        }
+
+        // the parsed ini is thrown away right after freezing it, so it lives in an arena
+        ini parsed = ini::with_arena();
+        parsed.m_comment_handles = options.comment_handles;
+        parsed.m_delim = options.delimiter;
+        parsed.read_buffer(source.view());
+
+        frozen_ini result = build(parsed);
+        try {
+            result.save_binary(cache_path, source_hash);
+        } catch (const std::system_error&) {
+            // the cache only saves time; a read-only location must not keep the configuration from loading
+        }
+        return result;
+    }
+
+    INICPP frozen_ini::section frozen_ini::find(std::string_view name) const noexcept {
+        if (!m_base) return section();
+
+        auto const& h = header();
+        std::uint32_t const index = probe(m_base, h.section_table, name_hash(name, h.salt));
+        if (index == detail::frozen_table::empty) return section();
+
+        auto const entry = reinterpret_cast<const detail::frozen_section*>(m_base + h.sections) + index;
+        if (!name_equals(m_base, entry->name, entry->name_length, name)) return section();
+        return section(m_base, entry);
+    }
+
+    INICPP frozen_ini::value frozen_ini::section::find(std::string_view key) const noexcept {
+        if (!m_entry || m_entry->key_count == 0) return value();
+
+        auto const& h = *reinterpret_cast<const detail::frozen_header*>(m_base);
+        std::uint32_t const index = probe(m_base, m_entry->key_table, name_hash(key, h.salt));
+        if (index == detail::frozen_table::empty) return value();
+
+        auto const entry = reinterpret_cast<const detail::frozen_key*>(m_base + h.keys) + m_entry->first_key + index;
+        if (!name_equals(m_base, entry->name, entry->name_length, key)) return value();
+        return value(m_base + entry->value, entry->value_length);
+    }
+}
@@ -0,0 +1,90 @@
+#ifndef INICPP_HASH_H
+#define INICPP_HASH_H 1
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string_view>
+
+namespace inicpp::detail {
+    /**
+     * @brief 64-bit finalizer from MurmurHash3. Every input bit affects every output bit.
+     */
+    constexpr inline std::uint64_t mix(std::uint64_t h) noexcept {
+        h ^= h >> 33;
+        h *= 0xff51afd7ed558ccdull;
+        h ^= h >> 33;
+        h *= 0xc4ceb9fe1a85ec53ull;
+        h ^= h >> 33;
+        return h;
+    }
+
+    /**
+     * @brief Hashes a byte string eight bytes at a time. Unlike @c std::hash the result does not depend on the standard
+     * library, so it may be stored in files and compared across builds on the same platform.
+     * @param bytes The bytes to hash
+     * @param seed Seed that selects an independent hash function
+     * @return The 64-bit hash
+     */
+    inline std::uint64_t hash_bytes(std::string_view bytes, std::uint64_t seed = 0) noexcept {
+        constexpr std::uint64_t multiplier = 0x9e3779b97f4a7c15ull;
+
+        const char* p = bytes.data();
+        std::size_t n = bytes.size();
+        std::uint64_t h = seed ^ (n * multiplier);
+
+        // long inputs are consumed 32 bytes at a time by four independent lanes, so that the multiplications overlap
+        if (n >= 32) {
+            std::uint64_t lanes[4] = { h, h ^ 1, h ^ 2, h ^ 3 };
+            for (; n >= 32; p += 32, n -= 32) {
+                for (int i = 0; i < 4; i++) {
+                    std::uint64_t word;
+                    std::memcpy(&word, p + i * 8, 8);
+                    lanes[i] = (lanes[i] ^ word) * multiplier;
+                    lanes[i] ^= lanes[i] >> 32;
+                }
+            }
+            h = mix(lanes[0]) ^ (mix(lanes[1]) * 3) ^ (mix(lanes[2]) * 5) ^ (mix(lanes[3]) * 7);
+        }
+
+        for (; n >= 8; p += 8, n -= 8) {
+            std::uint64_t word;
+            std::memcpy(&word, p, 8);
+            h = (h ^ word) * multiplier;
+            h ^= h >> 32;
+        }
+
+        // the tail is read with fixed-size loads, overlapping bytes that were already hashed where possible
+        if (n > 0) {
+            std::uint64_t word;
+            if (bytes.size() >= 8) {
+                std::memcpy(&word, bytes.data() + bytes.size() - 8, 8);
+            } else if (n >= 4) {
+                std::uint32_t low, high;
+                std::memcpy(&low, p, 4);
+                std::memcpy(&high, p + n - 4, 4);
+                word = (std::uint64_t(high) << 32) | low;
+            } else {
+                word = (std::uint64_t(static_cast<unsigned char>(p[0])) << 16) | (std::uint64_t(static_cast<unsigned char>(p[n / 2])) << 8)
+                    | static_cast<unsigned char>(p[n - 1]);
+            }
+            h = (h ^ word) * multiplier;
+            h ^= h >> 32;
+        }
+
+        return mix(h);
+    }
+
+    /**
+     * @brief Hashes the parser settings into a seed for @c hash_bytes, so that hashes of source text taken with different
+     * settings never match. The order of the comment handles does not matter.
+     */
+    template<typename Handles>
+    inline std::uint64_t settings_seed(const Handles& comment_handles, std::string_view delim) noexcept {
+        std::uint64_t seed = hash_bytes(delim);
+        for (auto const& handle : comment_handles) seed += hash_bytes(handle, 1);
+        return seed;
+    }
+}
+
+#endif
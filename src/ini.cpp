@@ -1,11 +1,26 @@
 #include "ini.hpp"
+#include "counting_resource.hpp"
+#include "frozen_ini.hpp"
+#include "parse_stats.hpp"
+#include "parser.hpp"
+#include "thread_pool.hpp"
 
 #include <stdexcept>
 #include <string>
 #include <string_view>
 #include <vector>
 #include <algorithm>
+#include <cstring>
+#include <atomic>
+#include <chrono>
+#include <exception>
+#include <limits>
+#include <memory>
 #include "parser_exception.hpp"
+#include "mapped_file.h"
+#include "replace_file.h"
+#include "tokenizer.h"
+#include "hash.h"
 
 template<typename CharT, typename Traits>
 typename std::basic_string_view<CharT, Traits>::size_type count(const std::basic_string_view<CharT, Traits> str, const std::basic_string_view<CharT, Traits> delim) noexcept {
@@ -165,6 +180,62 @@ inline std::basic_string_view<CharT, Traits> trim(std::basic_string<CharT, Trait
 }
 
 namespace inicpp {
+    INICPP ini::ini(const ini& other, const allocator_type& alloc)
+        : m_lookup_map(alloc), m_sections(alloc), m_comment_handles(other.m_comment_handles), m_delim(other.m_delim) {
+        // temporary sections are not carried over
+        for (auto const& section : other) push_back(section);
+    }
+
+    // the moved-from ini keeps its allocator, so it shares the arena rather than giving it up, like operator=(ini&&)
+    INICPP ini::ini(ini&& other) noexcept
+        : m_arena(other.m_arena), m_lookup_map(std::move(other.m_lookup_map)), m_sections(std::move(other.m_sections)),
+        m_comment_handles(std::move(other.m_comment_handles)), m_delim(std::move(other.m_delim)) {
+        adopt_sections();
+        other.clear();
+    }
+
+    INICPP ini& ini::operator=(const ini& other) {
+        if (this != &other) {
+            clear();
+            for (auto const& section : other) push_back(section);
+            m_comment_handles = other.m_comment_handles;
+            m_delim = other.m_delim;
+        }
+        return *this;
+    }
+
+    INICPP ini& ini::operator=(ini&& other) {
+        if (this == &other) return *this;
+        if (get_allocator() == other.get_allocator()) {
+            // the nodes are taken over as is, so the arena they live in has to be kept alive as well
+            m_lookup_map = std::move(other.m_lookup_map);
+            m_sections = std::move(other.m_sections);
+            if (other.m_arena) m_arena = other.m_arena;
+            adopt_sections();
+            m_generation = next_generation();
+        } else {
+            clear();
+            for (auto& section : other) push_back(std::move(section));
+        }
+        m_comment_handles = std::move(other.m_comment_handles);
+        m_delim = std::move(other.m_delim);
+        other.clear();
+        return *this;
+    }
+
+    INICPP ini ini::with_arena(std::size_t initial_size) {
+        auto arena = std::make_shared<std::pmr::monotonic_buffer_resource>(initial_size);
+        ini result{ allocator_type(arena.get()) };
+        result.m_arena = std::move(arena);
+        return result;
+    }
+
+    INICPP ini ini::with_arena(std::shared_ptr<std::pmr::memory_resource> arena) {
+        ini result{ allocator_type(arena.get()) };
+        result.m_arena = std::move(arena);
+        return result;
+    }
+
     INICPP ini_section& ini::find(const std::string& name) {
         {
             auto f = m_lookup_map.find(name);
@@ -183,36 +254,66 @@ namespace inicpp {
             if (f != m_lookup_map.end()) return *f->second;
         }
 
-        this->push_back(ini_section(name));
+        this->push_back(ini_section(std::move(name)));
         auto last = --end();
         last->m_exists = false;
         return *last;
     }
 
-    INICPP ini_section const& ini::find(const std::string& name) const {
+    INICPP ini_section& ini::find(std::string_view name) {
         {
             auto f = m_lookup_map.find(name);
             if (f != m_lookup_map.end()) return *f->second;
         }
-        const_cast<ini*>(this)->push_back(ini_section(name));
+
+        this->push_back(ini_section(std::string(name)));
         auto last = --end();
         last->m_exists = false;
         return *last;
     }
 
-    INICPP ini_section const& ini::find(std::string&& name) const {
-        {
-            auto f = m_lookup_map.find(name);
-            if (f != m_lookup_map.end()) return *f->second;
+    INICPP ini_section const& ini::find(std::string_view name) const {
+        auto f = m_lookup_map.find(name);
+        return f != m_lookup_map.end() ? *f->second : missing_section();
+    }
+
+    INICPP ini_section* ini::try_get(std::string_view name) noexcept {
+        auto f = m_lookup_map.find(name);
+        return f != m_lookup_map.end() && *f->second ? &*f->second : nullptr;
+    }
+
+    INICPP ini_section const* ini::try_get(std::string_view name) const noexcept {
+        auto f = m_lookup_map.find(name);
+        return f != m_lookup_map.end() && *f->second ? &*f->second : nullptr;
+    }
+
+    INICPP const ini_value* ini::resolve(key_handle& handle) const noexcept {
+        const ini_section* const section = try_get(std::string_view(handle.m_section));
+        const ini_value* const value = section ? section->try_get(handle.m_key) : nullptr;
+
+        // misses are not remembered, so a key that is added later is found without invalidating every handle
+        if (value) {
+            handle.m_value = value;
+            handle.m_generation = m_generation;
         }
-        const_cast<ini*>(this)->push_back(ini_section(std::move(name)));
-        auto last = --end();
-        last->m_exists = false;
-        return *last;
+        return value;
     }
 
+    INICPP std::uint64_t ini::next_generation() noexcept {
+        static std::atomic<std::uint64_t> generation{ 1 };
+        return generation.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    INICPP ini_section const& ini::missing_section() noexcept {
+        static const ini_section section = [] {
+            ini_section s;
+            s.m_exists = false;
+            return s;
+        }();
+        return section;
+    }
 
-    INICPP bool ini::contains(const std::string& name) const {
+    INICPP bool ini::contains(std::string_view name) const {
         auto f = m_lookup_map.find(name);
         return f != m_lookup_map.end() && (*f->second);
     }
@@ -245,112 +346,544 @@ namespace inicpp {
         return *f->second;
     }
 
-    INICPP void ini::read(std::istream& in) {
+    namespace {
+        typedef std::chrono::steady_clock stats_clock;
+
+        // Adds the time from its construction to its destruction to @p total, unless it is null
+        class phase_timer {
+        public:
+            inline explicit phase_timer(std::chrono::nanoseconds* total) noexcept : m_total(total) {
+                if (m_total) m_start = stats_clock::now();
+            }
+
+            inline ~phase_timer() {
+                if (m_total) *m_total += stats_clock::now() - m_start;
+            }
+
+            phase_timer(const phase_timer&) = delete;
+            phase_timer& operator=(const phase_timer&) = delete;
+        private:
+            std::chrono::nanoseconds* m_total;
+            stats_clock::time_point m_start;
+        };
+
+        // Resets @p stats, then fills in the totals of one read or reload of @p target when it goes out of scope
+        class stats_scope {
+        public:
+            stats_scope(parse_stats* stats, const ini& target) noexcept : m_stats(stats) {
+                if (!m_stats) return;
+                *m_stats = parse_stats();
+                m_resource = dynamic_cast<counting_resource*>(target.get_allocator().resource());
+                if (m_resource) {
+                    m_allocations = m_resource->allocations();
+                    m_bytes = m_resource->bytes_allocated();
+                }
+                m_start = stats_clock::now();
+            }
+
+            ~stats_scope() {
+                if (!m_stats) return;
+                m_stats->total_time = stats_clock::now() - m_start;
+                if (m_resource) {
+                    m_stats->resource_allocations = m_resource->allocations() - m_allocations;
+                    m_stats->resource_bytes = m_resource->bytes_allocated() - m_bytes;
+                }
+            }
+
+            stats_scope(const stats_scope&) = delete;
+            stats_scope& operator=(const stats_scope&) = delete;
+        private:
+            parse_stats* m_stats;
+            counting_resource* m_resource = nullptr;
+            std::size_t m_allocations = 0;
+            std::size_t m_bytes = 0;
+            stats_clock::time_point m_start;
+        };
+    }
+
+    /**
+     * @brief Tokenizer handler shared by every read entry point, which stores the tokens into an ini. Nothing is copied
+     * unless it is stored as a section name, key or value. If @c stats is set, what is stored is counted into it; the
+     * counting is kept out of line, so that reads without stats only pay for the null checks.
+     */
+    struct ini::reader {
+        explicit reader(ini& target, parse_stats* stats = nullptr);
+
+        inline void buffer(std::string_view buffer) {
+            if (stats) counted_buffer(buffer);
+            else tokens.buffer(buffer);
+        }
+
+        // Numbers the lines of the next buffer from @p line + 1 and its bytes from @p offset, for buffers that start in the middle of a file
+        inline void seek(std::size_t line, std::size_t offset) noexcept { tokens.seek(line, offset); }
+
+        void on_section(std::string_view name);
+
+        inline void on_key_value(std::string_view key, std::string_view value) {
+            if (stats) counted_key_value(key, value);
+            else (*section)[key].assign(value);
+        }
+
+        inline void on_comment(std::string_view) noexcept { if (stats) stats->comments++; }
+
+        inline void on_error(const parse_error& error) {
+            if (!errors) throw parser_exception(detail::format_error(error));
+            errors->push_back(error);
+        }
+
+        void counted_buffer(std::string_view buffer);
+        void counted_key_value(std::string_view key, std::string_view value);
+
+        ini& self;
+        parse_stats* stats;
+        std::vector<parse_error>* errors = nullptr;     // collects errors instead of throwing them, if set
+        ini_section* section = nullptr;
+        detail::tokenizer<reader> tokens;
+    };
+
+    ini::reader::reader(ini& target, parse_stats* stats) : self(target), stats(stats), tokens(*this, target.m_comment_handles, target.m_delim) {
+        phase_timer timer(stats ? &stats->prepare_time : nullptr);
+        self.m_generation = next_generation();
+
         // temporary objects are removed on read
-        for (auto b = this->m_sections.begin(); b != this->m_sections.end();) {
+        for (auto b = self.m_sections.begin(); b != self.m_sections.end();) {
             if (!b->m_exists) {
                 b->m_exists = true;
-                b = erase(const_iterator(b, m_sections)).m_cur;
+                b = self.erase(const_iterator(b, self.m_sections)).m_cur;
             } else { b->m_exists = false; ++b; }
         }
+    }
+
+    void ini::reader::on_section(const std::string_view name) {
+        phase_timer timer(stats ? &stats->insert_time : nullptr);
+        if (stats) {
+            if (self.m_lookup_map.find(name) != self.m_lookup_map.end()) stats->sections_reopened++;
+            else stats->sections_created++;
+        }
+
+        ini_section& sec = self[name];
+        sec.m_exists = true;
+        sec.m_source_hash = 0;
+        sec.m_ini = &self;
+        section = &sec;
+    }
+
+    void ini::reader::counted_buffer(const std::string_view buffer) {
+        std::size_t const first_line = tokens.line_number();
+        stats->bytes += buffer.length();
+
+        // the tokenizer stores every token as it finds it, so the insert time spent meanwhile is taken back out
+        std::chrono::nanoseconds const inserted = stats->insert_time;
+        stats_clock::time_point const start = stats_clock::now();
+        auto const count = [&] {
+            stats->tokenize_time += (stats_clock::now() - start) - (stats->insert_time - inserted);
+            stats->lines += tokens.line_number() - first_line;
+        };
+        try {
+            tokens.buffer(buffer);
+        } catch (const parser_exception&) {
+            // counted up to the line that failed
+            count();
+            throw;
+        }
+        count();
+    }
+
+    void ini::reader::counted_key_value(const std::string_view key, const std::string_view value) {
+        phase_timer timer(&stats->insert_time);
+
+        ini_value& target = (*section)[key];
+
+        // a key that was only looked up has no value yet, and counts as created
+        bool const overwritten = target.has_value();
+        target.assign(value);
+
+        if (overwritten) stats->keys_overwritten++;
+        else stats->keys_created++;
+    }
+
+    INICPP void ini::read(std::istream& in) {
+        reader r(*this);
+        detail::read_stream(in, r);
+    }
+
+    INICPP void ini::read(std::istream& in, parse_stats& stats) {
+        stats_scope scope(&stats, *this);
+        reader r(*this, &stats);
+        detail::read_stream(in, r);
+    }
+
+    INICPP void ini::read_buffer(const std::string_view buffer, parse_stats* const stats) {
+        stats_scope scope(stats, *this);
+        reader(*this, stats).buffer(buffer);
+    }
+
+    INICPP bool ini::read(std::istream& in, std::vector<parse_error>& errors) {
+        std::size_t const found = errors.size();
+        reader r(*this);
+        r.errors = &errors;
+        detail::read_stream(in, r);
+        return errors.size() == found;
+    }
+
+    INICPP bool ini::read_buffer(const std::string_view buffer, std::vector<parse_error>& errors) {
+        std::size_t const found = errors.size();
+        reader r(*this);
+        r.errors = &errors;
+        r.buffer(buffer);
+        return errors.size() == found;
+    }
+
+    INICPP void ini::read_file(const std::string& path) {
+        detail::mapped_file file(path);
+        reader(*this).buffer(file.view());
+    }
 
-        if (!in.eof()) {
-            std::string line;
-            size_t line_number = 0;
-            bool read_sec = true;
-            std::string_view trimmed_line;
-            while (in) {
-                if (read_sec) {
-                    if (!std::getline(in, line)) return;
-                    line_number++;
-                    trimmed_line = trim(line);
+    INICPP void ini::read_file(const std::string& path, parse_stats& stats) {
+        detail::mapped_file file(path);
+        stats_scope scope(&stats, *this);
+        reader(*this, &stats).buffer(file.view());
+    }
+
+    INICPP bool ini::read_file(const std::string& path, std::vector<parse_error>& errors) {
+        detail::mapped_file file(path);
+        return read_buffer(file.view(), errors);
+    }
+
+    namespace {
+        // Cuts @p buffer into about @p count chunks, each but the first starting at a section header line
+        std::vector<std::string_view> split_at_headers(const std::string_view buffer, const std::size_t count) {
+            const char* const begin = buffer.data();
+            const char* const end = begin + buffer.length();
+
+            std::vector<std::string_view> chunks;
+            chunks.reserve(count);
+
+            const char* start = begin;
+            for (std::size_t i = 1; i < count; i++) {
+                const char* cut = begin + buffer.length() / count * i;
+                if (cut <= start) continue;
+
+                // moves to the start of the next line, then on to the first line that is a header
+                cut = detail::end_of_line(cut - 1, end);
+                while (cut != end) {
+                    const char* const first = detail::skip_space(++cut, end);
+                    if (first != end && *first == '[') break;
+                    cut = detail::end_of_line(first, end);
                 }
+                if (cut == end) break;
+
+                chunks.emplace_back(start, cut - start);
+                start = cut;
+            }
+            chunks.emplace_back(start, end - start);
+            return chunks;
+        }
+
+        // Whether memory can be allocated from @p resource by several threads at once
+        inline bool is_thread_safe(std::pmr::memory_resource* resource) noexcept {
+            return resource == std::pmr::new_delete_resource() || dynamic_cast<std::pmr::synchronized_pool_resource*>(resource) != nullptr;
+        }
+    }
+
+    INICPP void ini::read_parallel(const std::string_view buffer, thread_pool& pool) {
+        // chunks smaller than this cost more to hand over than to parse
+        constexpr std::size_t min_chunk_size = std::size_t(256) * 1024;
+
+        std::size_t const wanted = std::min(pool.size() * 4, buffer.length() / min_chunk_size);
+        std::vector<std::string_view> texts = wanted > 1 ? split_at_headers(buffer, wanted) : std::vector<std::string_view>();
+        if (texts.size() < 2) {
+            read_buffer(buffer);
+            return;
+        }
+
+        // parsed sections are spliced over if both lists can share a resource, which is only safe if it is thread safe
+        bool const splice = is_thread_safe(get_allocator().resource());
+
+        std::vector<ini> parts;
+        parts.reserve(texts.size());
+        for (std::size_t i = 0; i < texts.size(); i++) {
+            parts.emplace_back(splice ? get_allocator() : allocator_type(std::pmr::new_delete_resource()));
+            parts.back().m_comment_handles = m_comment_handles;
+            parts.back().m_delim = m_delim;
+        }
+
+        // chunks are claimed in order, so chunks after a failed one are not parsed at all
+        std::vector<std::exception_ptr> errors(texts.size());
+        std::atomic<std::size_t> first_error{ std::size_t(-1) };
+        pool.run_indexed(texts.size(), [&](const std::size_t i) {
+            if (i > first_error.load(std::memory_order_relaxed)) return;
+            try {
+                reader(parts[i]).buffer(texts[i]);
+            } catch (...) {
+                errors[i] = std::current_exception();
+                for (std::size_t seen = first_error.load(std::memory_order_relaxed);
+                    i < seen && !first_error.compare_exchange_weak(seen, i, std::memory_order_relaxed););
+            }
+        });
+
+        // the merge goes through a reader, so that repeated sections and keys end up exactly as in a serial read
+        reader r(*this);
+        for (std::size_t i = 0; i < texts.size(); i++) {
+            if (errors[i]) {
+                // the failing chunk and everything after it is read serially, which stops at the same line as read() would
+                r.seek(static_cast<std::size_t>(std::count(buffer.data(), texts[i].data(), '\n')), texts[i].data() - buffer.data());
+                r.buffer(std::string_view(texts[i].data(), buffer.data() + buffer.length() - texts[i].data()));
+                return;
+            }
 
-                if (trimmed_line.length() == 0) continue;
-                if (trimmed_line[0] == '[') {
-                    std::size_t comment_handle_pos = std::string_view::npos;
-
-                    for (std::string const& comment_handle : m_comment_handles) {
-                        std::size_t const old_pos = comment_handle_pos;
-                        comment_handle_pos = std::min(trimmed_line.find(comment_handle, 1), old_pos);
-                        if (comment_handle_pos == 0) break;
-                    }
-
-                    std::size_t const end_section_pos = trimmed_line.find(']', 1);
-                    std::string_view name = trim(trimmed_line.substr(1, std::min(comment_handle_pos, end_section_pos) - 1));
-
-                    if (end_section_pos > comment_handle_pos || end_section_pos == std::string_view::npos) {
-                        // error, expected ']' to end section name
-                        in.setstate(std::ios_base::failbit);
-                        throw parser_exception(std::to_string(line_number) + ":" + std::to_string(name.data() - line.data() + name.length() + 1) + " Expected ']' before end of line");
-                        return;
-                    } else if (name.length() == 0) {
-                        // error, expected section name
-                        in.setstate(std::ios_base::failbit);
-                        throw parser_exception(std::to_string(line_number) + ":" + std::to_string(trimmed_line.data() - line.data() + 2) + " Expected valid section name before ']'");
-                        return;
-                    }
-
-                    ini_section& sec = (*this)[std::string(name)];
-                    sec.m_exists = true;
-                    sec.m_ini = this;
-
-                    if (end_section_pos != trimmed_line.length() - 1) {
-                        size_t next_valid_pos = end_section_pos + 1;
-                        for (;next_valid_pos < trimmed_line.length() && std::isspace(trimmed_line[next_valid_pos]); next_valid_pos++);
-                        if (next_valid_pos != comment_handle_pos) {
-                            // error, unexpected character `trimmed_line[next_valid_pos]`
-                            throw parser_exception(std::to_string(line_number) + ":" + std::to_string(trimmed_line.data() - line.data() + next_valid_pos + 1) + " Unexpected character");
-                            in.setstate(std::ios_base::failbit);
-                            return;
-                        }
-                    }
-
-                    read_sec = false;
-                    for (line_number++; std::getline(in, line); line_number++) {
-                        trimmed_line = trim(line);
-                        if (trimmed_line.length() == 0) continue;
-                        if (trimmed_line[0] == '[') break;
-                        comment_handle_pos = std::string_view::npos;
-
-                        for (std::string const& comment_handle : m_comment_handles) {
-                            std::size_t const old_pos = comment_handle_pos;
-                            comment_handle_pos = std::min(trimmed_line.find(comment_handle), old_pos);
-                            if (comment_handle_pos == 0) break;
-                        }
-                        std::string_view accessible_line = trimmed_line.substr(0, comment_handle_pos);
-                        if (accessible_line.length() == 0) continue;
-
-                        auto delim_pos = accessible_line.find(this->m_delim);
-                        if (delim_pos == std::string_view::npos) {
-                            // error, expected delimeter
-                            in.setstate(std::ios_base::failbit);
-                            throw parser_exception(std::to_string(line_number) + ":" + std::to_string(accessible_line.data() - line.data() + accessible_line.length() + 1) + " Expected delimeter before end of line");
-                            return;
-                        }
-                        sec[std::string(trim(accessible_line.substr(0, delim_pos)))].set_value(std::string(trim(accessible_line.substr(delim_pos + 1))));
-                    }
+            ini& part = parts[i];
+            for (auto node = part.m_sections.begin(); node != part.m_sections.end();) {
+                auto const current = node++;
+                if (splice && m_lookup_map.find(current->get_name()) == m_lookup_map.end()) {
+                    m_sections.splice(m_sections.end(), part.m_sections, current);
+                    current->m_ini = this;
+                    m_lookup_map.emplace(current->get_name(), current);
                 } else {
-                    bool found = std::find_if(m_comment_handles.begin(), m_comment_handles.end(),
-                        [&trimmed_line](const std::string& comment_handle) { return starts_with(trimmed_line, comment_handle); }) != m_comment_handles.end();
-                    if (!found) {
-                        // error, unexpected character `trimmed_line[0]`
-                        in.setstate(std::ios_base::failbit);
-                        throw parser_exception(std::to_string(line_number) + ":" + std::to_string(trimmed_line.data() - line.data() + 1) + " Unexpected character");
-                        return;
-                    }
+                    r.on_section(current->get_name());
+                    for (auto const& value : current->m_data) r.on_key_value(value.first, value.second.get_value());
                 }
             }
+            part.m_lookup_map.clear();
+        }
+    }
+
+    INICPP void ini::read_file_parallel(const std::string& path, thread_pool& pool) {
+        detail::mapped_file file(path);
+        read_parallel(file.view(), pool);
+    }
+
+    namespace {
+        // One section of a buffer that is being reloaded: its header line and everything up to the next header
+        struct section_chunk {
+            std::string_view name;
+            std::string_view text;
+            std::uint64_t hash;
+        };
+    }
+
+    INICPP void ini::reload(const std::string_view buffer) { reload_buffer(buffer, nullptr); }
+
+    INICPP void ini::reload(const std::string_view buffer, parse_stats& stats) { reload_buffer(buffer, &stats); }
+
+    INICPP void ini::reload_buffer(const std::string_view buffer, parse_stats* const stats) {
+        stats_scope scope(stats, *this);
+        stats_clock::time_point const start = stats ? stats_clock::now() : stats_clock::time_point();
+
+        // the hashes depend on the parser settings, so that changing them invalidates every section
+        std::uint64_t const seed = detail::settings_seed(m_comment_handles, m_delim);
+        m_generation = next_generation();
+
+        // split the buffer at the header lines, found by jumping from one '[' to the next; a key line never starts with '['
+        std::string_view preamble = buffer;
+        std::vector<section_chunk> chunks;
+        {
+            const char* const begin = buffer.data();
+            const char* const end = begin + buffer.length();
+
+            for (const char* open = begin; (open = static_cast<const char*>(std::memchr(open, '[', end - open))) != nullptr; open++) {
+                const char* line = open;
+                while (line != begin && line[-1] != '\n' && detail::is_space(line[-1])) --line;
+                if (line != begin && line[-1] != '\n') continue;
+
+                // the name is only used to pair chunks with sections; malformed headers are reported when the chunk is parsed
+                const char* const eol = detail::end_of_line(open, end);
+                const char* const close = static_cast<const char*>(std::memchr(open, ']', eol - open));
+                const char* const name_begin = detail::skip_space(open + 1, close ? close : eol);
+                const char* const name_end = detail::rskip_space(name_begin, close ? close : eol);
+
+                if (chunks.empty()) preamble = std::string_view(begin, line - begin);
+                else chunks.back().text = std::string_view(chunks.back().text.data(), line - chunks.back().text.data());
+                chunks.push_back({ std::string_view(name_begin, name_end - name_begin), std::string_view(line, end - line), 0 });
+
+                open = eol == end ? end - 1 : eol;
+            }
+        }
+
+        std::unordered_set<std::string_view> names;
+        names.reserve(chunks.size());
+        for (auto& chunk : chunks) {
+            if (!names.insert(chunk.name).second) {
+                // a section split over several places of the file cannot be patched chunk by chunk
+                ini next(get_allocator());
+                next.m_comment_handles = m_comment_handles;
+                next.m_delim = m_delim;
+                if (stats) stats->prepare_time += stats_clock::now() - start;
+                reader(next, stats).buffer(buffer);
+
+                phase_timer timer(stats ? &stats->insert_time : nullptr);
+                *this = std::move(next);
+                return;
+            }
+            chunk.hash = detail::hash_bytes(chunk.text, seed);
+        }
+        if (stats) stats->prepare_time += stats_clock::now() - start;
+
+        // changed sections are parsed into a scratch ini first, so that nothing is modified if the buffer is invalid
+        ini scratch(get_allocator());
+        scratch.m_comment_handles = m_comment_handles;
+        scratch.m_delim = m_delim;
+        {
+            reader r(scratch, stats);
+            r.buffer(preamble);
+
+            for (auto const& chunk : chunks) {
+                auto f = m_lookup_map.find(chunk.name);
+                if (f != m_lookup_map.end() && f->second->m_exists && f->second->m_source_hash == chunk.hash) {
+                    if (stats) stats->sections_unchanged++;
+                    continue;
+                }
+
+                try {
+                    r.seek(0, 0);
+                    r.buffer(chunk.text);
+                } catch (const parser_exception&) {
+                    // lines are only counted when an error has to be reported, by parsing the failing chunk again
+                    r.seek(static_cast<std::size_t>(std::count(buffer.data(), chunk.text.data(), '\n')), chunk.text.data() - buffer.data());
+                    r.buffer(chunk.text);
+                    throw;
+                }
+            }
+        }
+
+        // move everything into file order at the back of the list; whatever is left in front of it is gone from the file
+        phase_timer timer(stats ? &stats->insert_time : nullptr);
+        for (auto const& chunk : chunks) {
+            std::pmr::list<ini_section>::iterator node;
+            auto f = m_lookup_map.find(chunk.name);
+            auto parsed = scratch.m_lookup_map.find(chunk.name);
+
+            if (parsed == scratch.m_lookup_map.end()) {
+                node = f->second;
+            } else if (f != m_lookup_map.end()) {
+                node = f->second;
+                node->m_data = std::move(parsed->second->m_data);
+                node->adopt_values();
+            } else {
+                // both lists allocate from the same resource, so the parsed node can be taken over as is
+                node = parsed->second;
+                scratch.m_lookup_map.erase(parsed);
+                m_sections.splice(m_sections.end(), scratch.m_sections, node);
+                node->m_ini = this;
+                m_lookup_map.emplace(node->get_name(), node);
+            }
+
+            node->m_exists = true;
+            node->m_source_hash = chunk.hash;
+            m_sections.splice(m_sections.end(), m_sections, node);
+        }
+
+        for (std::size_t stale = m_sections.size() - chunks.size(); stale > 0; stale--) {
+            m_lookup_map.erase(m_sections.front().get_name());
+            m_sections.pop_front();
+        }
+    }
+
+    INICPP void ini::reload_file(const std::string& path) {
+        // Copied rather than mapped, like in file_watcher: a reloaded file is usually rewritten by other processes, and
+        // one that truncates it in place would turn a read of the mapping into SIGBUS.
+        std::string text;
+        detail::read_small_file(path, text, std::numeric_limits<std::size_t>::max());
+        reload_buffer(text, nullptr);
+    }
+
+    INICPP void ini::reload_file(const std::string& path, parse_stats& stats) {
+        std::string text;
+        detail::read_small_file(path, text, std::numeric_limits<std::size_t>::max());
+        reload_buffer(text, &stats);
+    }
+
+    INICPP frozen_ini ini::freeze() const { return frozen_ini::build(*this); }
+
+    INICPP void ini::thaw(const frozen_ini& snapshot) {
+        ini next(get_allocator());
+        next.m_comment_handles = m_comment_handles;
+        next.m_delim = m_delim;
+        next.m_lookup_map.reserve(snapshot.size());
+        {
+            reader r(next);
+            for (auto const section : snapshot) {
+                // the snapshot knows how many keys follow, so each section is sized once
+                r.on_section(section.get_name());
+                r.section->m_data.reserve(section.size());
+                for (auto const value : section) r.on_key_value(value.first, value.second.get_value());
+            }
+        }
+        *this = std::move(next);
+    }
+
+    INICPP void ini::save_binary(const std::string& path) const { freeze().save_binary(path); }
+
+    INICPP void ini::load_binary(const std::string& path) { thaw(frozen_ini::load_binary(path)); }
+
+    INICPP void ini::read_file_cached(const std::string& path, const std::string& cache_path) {
+        parse_options options;
+        options.comment_handles = m_comment_handles;
+        options.delimiter = m_delim;
+        thaw(frozen_ini::read_file_cached(path, cache_path, options));
+    }
+
+    namespace {
+        // Exact number of bytes write_section produces for @p section
+        std::size_t section_size(const ini_section& section, std::size_t delim_length) noexcept {
+            std::size_t size = section.get_name().length() + 4;
+            for (auto const& value : section) size += value.first.length() + delim_length + value.second.get_value().length() + 1;
+            return size;
+        }
+
+        inline char* put(char* out, std::string_view text) noexcept {
+            std::memcpy(out, text.data(), text.length());
+            return out + text.length();
+        }
+
+        // Formats a section with its keys and the blank line that follows it, returning the end of the output
+        char* write_section(char* out, const ini_section& section, std::string_view delim) noexcept {
+            *out++ = '[';
+            out = put(out, section.get_name());
+            *out++ = ']';
+            *out++ = '\n';
+            for (auto const& value : section) {
+                out = put(out, value.first);
+                out = put(out, delim);
+                out = put(out, value.second.get_value());
+                *out++ = '\n';
+            }
+            *out++ = '\n';
+            return out;
         }
     }
 
     INICPP void ini::write(std::ostream& out) const {
+        // sections are formatted into one reusable buffer, which is handed to the stream whenever the next one does not fit
+        constexpr std::size_t buffer_size = std::size_t(64) * 1024;
+
+        std::string buffer;
+        std::size_t used = 0;
         for (auto const& section : *this) {
-            out << '[' << section.get_name() << "]\n";
-            for (auto const& value : section) {
-                out << value.first << m_delim << value.second.get_value() << '\n';
+            std::size_t const size = section_size(section, m_delim.length());
+            if (used + size > buffer.length()) {
+                out.write(buffer.data(), static_cast<std::streamsize>(used));
+                used = 0;
+                if (size > buffer.length()) buffer.resize(std::max(size, buffer_size));
             }
-            out << '\n';
+            write_section(&buffer[used], section, m_delim);
+            used += size;
         }
+        out.write(buffer.data(), static_cast<std::streamsize>(used));
+    }
+
+    INICPP void ini::write(std::string& out) const {
+        std::size_t size = 0;
+        for (auto const& section : *this) size += section_size(section, m_delim.length());
+
+        out.resize(size);
+        char* cur = out.data();
+        for (auto const& section : *this) cur = write_section(cur, section, m_delim);
+    }
+
+    INICPP void ini::write_file(const std::string& path) const {
+        std::string text;
+        write(text);
+        detail::replace_file(path, text);
     }
 }
\ No newline at end of file
@@ -7,9 +7,13 @@ namespace inicpp {
             if (this->m_ini) {
                 if (this->m_ini->contains(name)) throw std::invalid_argument("ini_section::set_name");
 
+                // the index key views m_name, so it has to be dropped before the name changes
                 auto pos = this->m_ini->m_lookup_map.find(this->m_name);
-                this->m_ini->m_lookup_map[this->m_name = name] = pos->second;
+                auto const section = pos->second;
                 this->m_ini->m_lookup_map.erase(pos);
+                this->m_name = name;
+                this->m_ini->m_lookup_map.emplace(this->m_name, section);
+                invalidate_handles();
             } else { this->m_name = name; }
         }
     }
@@ -19,28 +23,28 @@ namespace inicpp {
             if (this->m_ini) {
                 if (this->m_ini->contains(name)) throw std::invalid_argument("ini_section::set_name");
 
+                // the index key views m_name, so it has to be dropped before the name changes
                 auto pos = this->m_ini->m_lookup_map.find(this->m_name);
-                this->m_ini->m_lookup_map[this->m_name = std::move(name)] = pos->second;
+                auto const section = pos->second;
                 this->m_ini->m_lookup_map.erase(pos);
+                this->m_name = std::move(name);
+                this->m_ini->m_lookup_map.emplace(this->m_name, section);
+                invalidate_handles();
             } else { this->m_name = std::move(name); }
         }
     }
 
-    INICPP const ini_value& ini_section::find(const std::string& key) const {
-        {
-            auto f = m_data.find(key);
-            if (f != m_data.end()) return f->second;
-        }
-        const_cast<ini_section*>(this)->push_back({ key, ini_value() });
-        return this->back().second;
+    INICPP const ini_value& ini_section::find(std::string_view key) const {
+        auto f = m_data.find(key);
+        return f != m_data.end() ? f->second : missing_value();
     }
 
-    INICPP const ini_value& ini_section::find(std::string&& key) const {
-        {
-            auto f = m_data.find(key);
-            if (f != m_data.end()) return f->second;
-        }
-        const_cast<ini_section*>(this)->push_back({ std::move(key), ini_value() });
-        return this->back().second;
+    INICPP void ini_section::invalidate_handles() noexcept {
+        if (this->m_ini) this->m_ini->m_generation = ini::next_generation();
+    }
+
+    INICPP const ini_value& ini_section::missing_value() noexcept {
+        static const ini_value value;
+        return value;
     }
-}
\ No newline at end of file
+}
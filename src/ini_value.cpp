@@ -4,11 +4,38 @@
 namespace inicpp {
     INICPP void ini_value::set_value(const std::string& data) {
         this->m_data = data;
-        if (m_section) m_section->m_exists = true;
+        m_cache.clear();
+        if (m_section) m_section->touch();
     }
 
     INICPP void ini_value::set_value(std::string&& data) noexcept {
         this->m_data = std::move(data);
-        if (m_section) m_section->m_exists = true;
+        m_cache.clear();
+        if (m_section) m_section->touch();
+    }
+
+    INICPP ini_value& ini_value::operator =(const ini_value& other) {
+        if (this != &other) {
+            this->m_data = other.m_data;
+            m_cache = other.m_cache;
+            if (m_section) m_section->touch();
+        }
+        return *this;
+    }
+
+    INICPP ini_value& ini_value::operator =(ini_value&& other) noexcept {
+        if (this != &other) {
+            this->m_data = std::move(other.m_data);
+            m_cache = other.m_cache;
+            if (m_section) m_section->touch();
+        }
+        return *this;
+    }
+
+    INICPP void ini_value::assign(std::string_view data) {
+        if (this->m_data) this->m_data->assign(data.data(), data.length());
+        else this->m_data.emplace(data);
+        m_cache.clear();
+        if (m_section) m_section->touch();
     }
 }
@@ -0,0 +1,65 @@
+#include "load_many.hpp"
+
+#include <algorithm>
+#include <memory>
+#include <memory_resource>
+#include <optional>
+#include <utility>
+#include "mapped_file.h"
+
+namespace inicpp {
+    namespace {
+        // Files up to this size are read into a buffer; mapping and unmapping them would cost more than copying
+        constexpr std::size_t max_read_size = std::size_t(256) * 1024;
+
+        // Runs of neighbouring files handed out per thread, so that threads that drew slow files are helped by the others
+        constexpr std::size_t runs_per_thread = 4;
+    }
+
+    INICPP std::vector<load_result> load_many(const std::vector<std::string>& paths, thread_pool& pool, const load_options& options) {
+        if (paths.empty()) return {};
+
+        std::vector<std::optional<ini>> documents(paths.size());
+        std::vector<std::exception_ptr> errors(paths.size());
+
+        // each run reuses one read buffer and, if enabled, one arena at a time
+        std::size_t const runs = std::min(paths.size(), (pool.size() + 1) * runs_per_thread);
+        pool.run_indexed(runs, [&](const std::size_t run) {
+            std::string text;
+            std::shared_ptr<std::pmr::memory_resource> arena;
+            std::size_t arena_used = 0;
+
+            for (std::size_t i = paths.size() * run / runs, last = paths.size() * (run + 1) / runs; i < last; i++) {
+                try {
+                    if (options.shared_arena_size > 0 && (!arena || arena_used >= options.shared_arena_size)) {
+                        arena = std::make_shared<std::pmr::monotonic_buffer_resource>(options.shared_arena_size);
+                        arena_used = 0;
+                    }
+
+                    ini& document = arena ? documents[i].emplace(ini::with_arena(arena)) : documents[i].emplace();
+                    document.get_comment_handles() = options.syntax.comment_handles;
+                    document.set_delimeter(options.syntax.delimiter);
+
+                    if (detail::read_small_file(paths[i], text, max_read_size)) {
+                        arena_used += text.length();
+                        document.read(text);
+                    } else {
+                        document.read_file(paths[i]);
+                    }
+                } catch (...) {
+                    errors[i] = std::current_exception();
+                }
+            }
+        });
+
+        // moving an ini keeps its allocator, so documents stay in their arenas
+        std::vector<load_result> results;
+        results.reserve(paths.size());
+        for (std::size_t i = 0; i < paths.size(); i++) {
+            std::optional<ini>& document = documents[i];
+            results.push_back(load_result{ document ? std::move(*document) : ini(), errors[i] });
+            document.reset();
+        }
+        return results;
+    }
+}
@@ -0,0 +1,195 @@
+#include "mapped_file.h"
+
+#include <system_error>
+#include <utility>
+
+#ifdef _WIN32
+#   ifndef WIN32_LEAN_AND_MEAN
+#       define WIN32_LEAN_AND_MEAN
+#   endif
+#   ifndef NOMINMAX
+#       define NOMINMAX
+#   endif
+#   include <windows.h>
+#else
+#   include <fcntl.h>
+#   include <sys/mman.h>
+#   include <sys/stat.h>
+#   include <unistd.h>
+#   include <cerrno>
+#endif
+
+namespace inicpp::detail {
+#ifdef _WIN32
+    mapped_file::mapped_file(const std::string& path) {
+        HANDLE file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ | FILE_SHARE_DELETE, nullptr,
+            OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+        if (file == INVALID_HANDLE_VALUE)
+            throw std::system_error(static_cast<int>(GetLastError()), std::system_category(), "mapped_file: " + path);
+        m_file = file;
+
+        LARGE_INTEGER size;
+        if (!GetFileSizeEx(file, &size)) {
+            auto error = static_cast<int>(GetLastError());
+            release();
+            throw std::system_error(error, std::system_category(), "mapped_file: " + path);
+        }
+
+        m_size = static_cast<std::size_t>(size.QuadPart);
+        if (m_size == 0) return;
+
+        HANDLE mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+        if (!mapping) {
+            auto error = static_cast<int>(GetLastError());
+            release();
+            throw std::system_error(error, std::system_category(), "mapped_file: " + path);
+        }
+        m_mapping = mapping;
+
+        m_data = static_cast<const char*>(MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0));
+        if (!m_data) {
+            auto error = static_cast<int>(GetLastError());
+            release();
+            throw std::system_error(error, std::system_category(), "mapped_file: " + path);
+        }
+    }
+
+    void mapped_file::release() noexcept {
+        if (m_data) UnmapViewOfFile(m_data);
+        if (m_mapping) CloseHandle(static_cast<HANDLE>(m_mapping));
+        if (m_file) CloseHandle(static_cast<HANDLE>(m_file));
+        m_data = nullptr;
+        m_mapping = m_file = nullptr;
+        m_size = 0;
+    }
+
+    bool read_small_file(const std::string& path, std::string& buffer, const std::size_t max_size) {
+        HANDLE file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ | FILE_SHARE_DELETE, nullptr,
+            OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+        if (file == INVALID_HANDLE_VALUE)
+            throw std::system_error(static_cast<int>(GetLastError()), std::system_category(), "read_small_file: " + path);
+
+        LARGE_INTEGER size;
+        if (!GetFileSizeEx(file, &size)) {
+            auto error = static_cast<int>(GetLastError());
+            CloseHandle(file);
+            throw std::system_error(error, std::system_category(), "read_small_file: " + path);
+        }
+        if (static_cast<unsigned long long>(size.QuadPart) > max_size) {
+            CloseHandle(file);
+            return false;
+        }
+
+        // a file that shrinks while it is read ends early; one that grows is cut at its old size
+        buffer.resize(static_cast<std::size_t>(size.QuadPart));
+        std::size_t filled = 0;
+        while (filled < buffer.length()) {
+            DWORD read = 0;
+            if (!ReadFile(file, &buffer[filled], static_cast<DWORD>(buffer.length() - filled), &read, nullptr)) {
+                auto error = static_cast<int>(GetLastError());
+                CloseHandle(file);
+                throw std::system_error(error, std::system_category(), "read_small_file: " + path);
+            }
+            if (read == 0) break;
+            filled += read;
+        }
+        buffer.resize(filled);
+
+        CloseHandle(file);
+        return true;
+    }
+#else
+    mapped_file::mapped_file(const std::string& path) {
+        int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+        if (fd < 0) throw std::system_error(errno, std::generic_category(), "mapped_file: " + path);
+
+        struct stat st;
+        if (::fstat(fd, &st) != 0) {
+            int error = errno;
+            ::close(fd);
+            throw std::system_error(error, std::generic_category(), "mapped_file: " + path);
+        }
+
+        m_size = static_cast<std::size_t>(st.st_size);
+        if (m_size > 0) {
+            void* data = ::mmap(nullptr, m_size, PROT_READ, MAP_PRIVATE, fd, 0);
+            if (data == MAP_FAILED) {
+                int error = errno;
+                ::close(fd);
+                m_size = 0;
+                throw std::system_error(error, std::generic_category(), "mapped_file: " + path);
+            }
+#ifdef MADV_SEQUENTIAL
+            ::madvise(data, m_size, MADV_SEQUENTIAL);
+#endif
+            m_data = static_cast<const char*>(data);
+        }
+
+        // the mapping keeps the file referenced
+        ::close(fd);
+    }
+
+    void mapped_file::release() noexcept {
+        if (m_data) ::munmap(const_cast<char*>(m_data), m_size);
+        m_data = nullptr;
+        m_size = 0;
+    }
+
+    bool read_small_file(const std::string& path, std::string& buffer, const std::size_t max_size) {
+        int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+        if (fd < 0) throw std::system_error(errno, std::generic_category(), "read_small_file: " + path);
+
+        struct stat st;
+        if (::fstat(fd, &st) != 0) {
+            int error = errno;
+            ::close(fd);
+            throw std::system_error(error, std::generic_category(), "read_small_file: " + path);
+        }
+        if (static_cast<unsigned long long>(st.st_size) > max_size) {
+            ::close(fd);
+            return false;
+        }
+
+        // a file that shrinks while it is read ends early; one that grows is cut at its old size
+        buffer.resize(static_cast<std::size_t>(st.st_size));
+        std::size_t filled = 0;
+        while (filled < buffer.length()) {
+            ssize_t const read = ::read(fd, &buffer[filled], buffer.length() - filled);
+            if (read < 0) {
+                if (errno == EINTR) continue;
+                int error = errno;
+                ::close(fd);
+                throw std::system_error(error, std::generic_category(), "read_small_file: " + path);
+            }
+            if (read == 0) break;
+            filled += static_cast<std::size_t>(read);
+        }
+        buffer.resize(filled);
+
+        ::close(fd);
+        return true;
+    }
+#endif
+
+    mapped_file::mapped_file(mapped_file&& other) noexcept
+        : m_data(std::exchange(other.m_data, nullptr)), m_size(std::exchange(other.m_size, 0))
+#ifdef _WIN32
+        , m_file(std::exchange(other.m_file, nullptr)), m_mapping(std::exchange(other.m_mapping, nullptr))
+#endif
+    {}
+
+    mapped_file::~mapped_file() { release(); }
+
+    mapped_file& mapped_file::operator=(mapped_file&& other) noexcept {
+        if (this != &other) {
+            release();
+            m_data = std::exchange(other.m_data, nullptr);
+            m_size = std::exchange(other.m_size, 0);
+#ifdef _WIN32
+            m_file = std::exchange(other.m_file, nullptr);
+            m_mapping = std::exchange(other.m_mapping, nullptr);
+#endif
+        }
+        return *this;
+    }
+}
@@ -0,0 +1,50 @@
+#ifndef INICPP_MAPPED_FILE_H
+#define INICPP_MAPPED_FILE_H 1
+
+#include <cstddef>
+#include <string>
+#include <string_view>
+
+namespace inicpp::detail {
+    /**
+     * @brief Read-only view of a whole file. On POSIX and Windows the file is memory mapped, so the parser
+     * can walk the contents as one contiguous buffer without copying it into a stream first.
+     */
+    class mapped_file {
+    public:
+        /**
+         * @brief Maps the file at @p path. If the file cannot be opened or mapped, an exception of type @c std::system_error is thrown.
+         * @param path Path of the file to map
+         */
+        explicit mapped_file(const std::string& path);
+        mapped_file(const mapped_file&) = delete;
+        mapped_file(mapped_file&& other) noexcept;
+        ~mapped_file();
+
+        mapped_file& operator=(const mapped_file&) = delete;
+        mapped_file& operator=(mapped_file&& other) noexcept;
+
+        inline const char* data() const noexcept { return m_data; }
+        inline std::size_t size() const noexcept { return m_size; }
+        inline std::string_view view() const noexcept { return std::string_view(m_data, m_size); }
+    private:
+        void release() noexcept;
+
+        const char* m_data = nullptr;
+        std::size_t m_size = 0;
+#ifdef _WIN32
+        void* m_file = nullptr;
+        void* m_mapping = nullptr;
+#endif
+    };
+
+    /**
+     * @brief Reads the file at @p path into @p buffer, reusing its capacity, unless the file is larger than @p max_size.
+     * Small files are cheaper to read than to map and unmap. If the file cannot be opened or read, an exception of type
+     * @c std::system_error is thrown.
+     * @return Whether the file was read; false if it is too large, in which case @p buffer is left as is
+     */
+    bool read_small_file(const std::string& path, std::string& buffer, std::size_t max_size);
+}
+
+#endif
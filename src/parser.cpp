@@ -0,0 +1,25 @@
+#include "parser.hpp"
+#include "parser_exception.hpp"
+#include "mapped_file.h"
+#include "tokenizer.h"
+
+namespace inicpp {
+    INICPP std::string to_string(const parse_error& error) { return detail::format_error(error); }
+
+    INICPP void parse_handler::on_error(const parse_error& error) { throw parser_exception(detail::format_error(error)); }
+
+    INICPP void parse(const std::string_view source, parse_handler& handler, const parse_options& options) {
+        detail::tokenizer<parse_handler> tokens(handler, options.comment_handles, options.delimiter);
+        tokens.buffer(source);
+    }
+
+    INICPP void parse(std::istream& in, parse_handler& handler, const parse_options& options) {
+        detail::tokenizer<parse_handler> tokens(handler, options.comment_handles, options.delimiter);
+        detail::read_stream(in, tokens);
+    }
+
+    INICPP void parse_file(const std::string& path, parse_handler& handler, const parse_options& options) {
+        detail::mapped_file file(path);
+        parse(file.view(), handler, options);
+    }
+}
@@ -0,0 +1,99 @@
+#include "replace_file.h"
+
+#include <string>
+#include <system_error>
+
+#ifdef _WIN32
+#   ifndef WIN32_LEAN_AND_MEAN
+#       define WIN32_LEAN_AND_MEAN
+#   endif
+#   ifndef NOMINMAX
+#       define NOMINMAX
+#   endif
+#   include <windows.h>
+#   include <algorithm>
+#else
+#   include <fcntl.h>
+#   include <sys/stat.h>
+#   include <unistd.h>
+#   include <atomic>
+#   include <cerrno>
+#endif
+
+namespace inicpp::detail {
+#ifdef _WIN32
+    void replace_file(const std::string& path, const std::string_view contents) {
+        // the temporary file has to be on the same volume for the move to be atomic, and unique to this writer
+        std::string const temp = path + ".tmp." + std::to_string(GetCurrentProcessId()) + "." + std::to_string(GetCurrentThreadId());
+
+        HANDLE file = CreateFileA(temp.c_str(), GENERIC_WRITE, 0, nullptr, CREATE_ALWAYS, FILE_ATTRIBUTE_NORMAL, nullptr);
+        if (file == INVALID_HANDLE_VALUE)
+            throw std::system_error(static_cast<int>(GetLastError()), std::system_category(), "replace_file: " + temp);
+
+        auto const fail = [&](DWORD error) {
+            if (file != INVALID_HANDLE_VALUE) CloseHandle(file);
+            DeleteFileA(temp.c_str());
+            throw std::system_error(static_cast<int>(error), std::system_category(), "replace_file: " + path);
+        };
+
+        for (std::size_t offset = 0; offset < contents.length();) {
+            DWORD const chunk = static_cast<DWORD>(std::min<std::size_t>(contents.length() - offset, 1u << 30));
+            DWORD written = 0;
+            if (!WriteFile(file, contents.data() + offset, chunk, &written, nullptr)) fail(GetLastError());
+            offset += written;
+        }
+        if (!FlushFileBuffers(file)) fail(GetLastError());
+
+        CloseHandle(file);
+        file = INVALID_HANDLE_VALUE;
+        if (!MoveFileExA(temp.c_str(), path.c_str(), MOVEFILE_REPLACE_EXISTING | MOVEFILE_WRITE_THROUGH)) fail(GetLastError());
+    }
+#else
+    void replace_file(const std::string& path, const std::string_view contents) {
+        // The temporary file has to be on the same file system for the rename to be atomic. It is created with open
+        // rather than mkstemp so that a new file gets 0666 minus the umask, like any other file the process creates.
+        static std::atomic<unsigned> counter{ 0 };
+        std::string temp;
+        int fd = -1;
+        while (fd < 0) {
+            temp = path + ".tmp." + std::to_string(::getpid()) + "." + std::to_string(counter.fetch_add(1, std::memory_order_relaxed));
+            fd = ::open(temp.c_str(), O_WRONLY | O_CREAT | O_EXCL | O_CLOEXEC, 0666);
+            if (fd < 0 && errno != EEXIST && errno != EINTR) throw std::system_error(errno, std::generic_category(), "replace_file: " + path);
+        }
+
+        auto const fail = [&](int error) {
+            if (fd >= 0) ::close(fd);
+            ::unlink(temp.c_str());
+            throw std::system_error(error, std::generic_category(), "replace_file: " + path);
+        };
+
+        // a replaced file keeps its mode
+        struct stat st;
+        if (::stat(path.c_str(), &st) == 0 && ::fchmod(fd, st.st_mode & 07777) != 0) fail(errno);
+
+        for (std::size_t offset = 0; offset < contents.length();) {
+            ssize_t const written = ::write(fd, contents.data() + offset, contents.length() - offset);
+            if (written < 0) {
+                if (errno == EINTR) continue;
+                fail(errno);
+            }
+            offset += static_cast<std::size_t>(written);
+        }
+        if (::fsync(fd) != 0) fail(errno);
+
+        int const closed = ::close(fd);
+        fd = -1;
+        if (closed != 0) fail(errno);
+        if (::rename(temp.c_str(), path.c_str()) != 0) fail(errno);
+
+        // the rename itself only survives a crash once the directory is flushed as well
+        std::string::size_type const slash = path.rfind('/');
+        std::string const directory = slash == std::string::npos ? std::string(".") : slash == 0 ? std::string("/") : path.substr(0, slash);
+        int const dir = ::open(directory.c_str(), O_RDONLY | O_CLOEXEC);
+        if (dir >= 0) {
+            ::fsync(dir);
+            ::close(dir);
+        }
+    }
+#endif
+}
@@ -0,0 +1,19 @@
+#ifndef INICPP_REPLACE_FILE_H
+#define INICPP_REPLACE_FILE_H 1
+
+#include <string>
+#include <string_view>
+
+namespace inicpp::detail {
+    /**
+     * @brief Replaces the file at @p path with @p contents so that readers see either the old or the new file, never a
+     * partial one. The contents are written to a temporary file next to @p path, flushed to disk and renamed over it.
+     * An existing file keeps its permissions. On failure the temporary file is removed, the original is left untouched
+     * and an exception of type @c std::system_error is thrown.
+     * @param path Path of the file to replace
+     * @param contents The new contents
+     */
+    void replace_file(const std::string& path, std::string_view contents);
+}
+
+#endif
@@ -0,0 +1,147 @@
+#include "scanner.h"
+
+#if !defined(INICPP_NO_SIMD) && (defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2))
+#   define INICPP_SCANNER_SSE2 1
+#   include <emmintrin.h>
+#   if defined(__GNUC__) || defined(__clang__)
+#       define INICPP_SCANNER_AVX2 1
+#       define INICPP_TARGET_AVX2 __attribute__((target("avx2")))
+#       include <immintrin.h>
+#   elif defined(_MSC_VER)
+#       define INICPP_SCANNER_AVX2 1
+#       define INICPP_TARGET_AVX2
+#       include <immintrin.h>
+#       include <intrin.h>
+#   endif
+#endif
+
+namespace inicpp::detail {
+    namespace {
+#ifdef INICPP_SCANNER_SSE2
+        inline unsigned trailing_zeros(unsigned mask) noexcept {
+#   ifdef _MSC_VER
+            unsigned long index;
+            _BitScanForward(&index, mask);
+            return static_cast<unsigned>(index);
+#   else
+            return static_cast<unsigned>(__builtin_ctz(mask));
+#   endif
+        }
+#endif
+
+#ifdef INICPP_SCANNER_AVX2
+        bool cpu_has_avx2() noexcept {
+#   ifdef _MSC_VER
+            int info[4];
+            __cpuid(info, 0);
+            if (info[0] < 7) return false;
+            __cpuid(info, 1);
+            // the OS must save the ymm registers
+            if (!(info[2] & (1 << 27)) || (_xgetbv(0) & 6) != 6) return false;
+            __cpuidex(info, 7, 0);
+            return (info[1] & (1 << 5)) != 0;
+#   else
+            __builtin_cpu_init();
+            return __builtin_cpu_supports("avx2");
+#   endif
+        }
+#endif
+    }
+
+    byte_scanner::byte_scanner(std::string_view bytes) noexcept {
+        for (char c : bytes) {
+            unsigned char const b = static_cast<unsigned char>(c);
+            if (m_table[b]) continue;
+            m_table[b] = true;
+            if (m_count < max_vector_bytes) m_bytes[m_count] = b;
+            m_count++;
+        }
+
+        m_find = m_count <= max_vector_bytes ? select() : find_scalar;
+    }
+
+    const char* byte_scanner::find_scalar(const byte_scanner& self, const char* begin, const char* end) noexcept {
+        for (; begin != end && !self.m_table[static_cast<unsigned char>(*begin)]; ++begin);
+        return begin;
+    }
+
+#ifdef INICPP_SCANNER_SSE2
+    const char* byte_scanner::find_sse2(const byte_scanner& self, const char* begin, const char* end) noexcept {
+        __m128i needles[max_vector_bytes];
+        for (std::size_t i = 0; i < self.m_count; i++) needles[i] = _mm_set1_epi8(static_cast<char>(self.m_bytes[i]));
+
+        for (; end - begin >= 16; begin += 16) {
+            __m128i const block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(begin));
+            __m128i hits = _mm_cmpeq_epi8(block, needles[0]);
+            for (std::size_t i = 1; i < self.m_count; i++) hits = _mm_or_si128(hits, _mm_cmpeq_epi8(block, needles[i]));
+
+            unsigned const mask = static_cast<unsigned>(_mm_movemask_epi8(hits));
+            if (mask) return begin + trailing_zeros(mask);
+        }
+
+        return find_scalar(self, begin, end);
+    }
+#else
+    const char* byte_scanner::find_sse2(const byte_scanner& self, const char* begin, const char* end) noexcept {
+        return find_scalar(self, begin, end);
+    }
+#endif
+
+#ifdef INICPP_SCANNER_AVX2
+    INICPP_TARGET_AVX2 const char* byte_scanner::find_avx2(const byte_scanner& self, const char* begin, const char* end) noexcept {
+        __m256i needles[max_vector_bytes];
+        for (std::size_t i = 0; i < self.m_count; i++) needles[i] = _mm256_set1_epi8(static_cast<char>(self.m_bytes[i]));
+
+        for (; end - begin >= 32; begin += 32) {
+            __m256i const block = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(begin));
+            __m256i hits = _mm256_cmpeq_epi8(block, needles[0]);
+            for (std::size_t i = 1; i < self.m_count; i++) hits = _mm256_or_si256(hits, _mm256_cmpeq_epi8(block, needles[i]));
+
+            unsigned const mask = static_cast<unsigned>(_mm256_movemask_epi8(hits));
+            if (mask) return begin + trailing_zeros(mask);
+        }
+
+        return find_sse2(self, begin, end);
+    }
+#else
+    const char* byte_scanner::find_avx2(const byte_scanner& self, const char* begin, const char* end) noexcept {
+        return find_sse2(self, begin, end);
+    }
+#endif
+
+    bool byte_scanner::supported(const kernel k) noexcept {
+        switch (k) {
+#ifdef INICPP_SCANNER_AVX2
+            case kernel::avx2: return cpu_has_avx2();
+#endif
+#ifdef INICPP_SCANNER_SSE2
+            case kernel::sse2: return true;
+#endif
+            case kernel::scalar: return true;
+            default: return false;
+        }
+    }
+
+    const char* byte_scanner::find_with(const kernel k, const char* begin, const char* end) const noexcept {
+        if (m_count > max_vector_bytes) return find_scalar(*this, begin, end);
+        switch (k) {
+            case kernel::avx2: return find_avx2(*this, begin, end);
+            case kernel::sse2: return find_sse2(*this, begin, end);
+            default: return find_scalar(*this, begin, end);
+        }
+    }
+
+    byte_scanner::find_function byte_scanner::select() noexcept {
+        static const find_function selected = []() noexcept -> find_function {
+#ifdef INICPP_SCANNER_AVX2
+            if (cpu_has_avx2()) return find_avx2;
+#endif
+#ifdef INICPP_SCANNER_SSE2
+            return find_sse2;
+#else
+            return find_scalar;
+#endif
+        }();
+        return selected;
+    }
+}
@@ -0,0 +1,66 @@
+#ifndef INICPP_SCANNER_H
+#define INICPP_SCANNER_H 1
+
+#include <cstddef>
+#include <string_view>
+
+namespace inicpp::detail {
+    /**
+     * @brief Finds the next occurrence of any byte out of a small set of structural bytes (newlines, brackets,
+     * delimiter and comment starts). The search compares 16 (SSE2) or 32 (AVX2) bytes at a time; the widest
+     * kernel supported by the CPU is picked once at runtime, with a table-driven scalar fallback.
+     */
+    class byte_scanner {
+    public:
+        // Sets larger than this are searched with the scalar kernel
+        static constexpr std::size_t max_vector_bytes = 8;
+
+        enum class kernel { scalar, sse2, avx2 };
+
+        /**
+         * @brief Constructs a scanner for the given set of bytes. Duplicate bytes are ignored.
+         * @param bytes The structural bytes to search for
+         */
+        explicit byte_scanner(std::string_view bytes) noexcept;
+
+        /**
+         * @brief Finds the first byte in [begin, end) that belongs to the set.
+         * @return Pointer to the matching byte, or @p end if there is none
+         */
+        inline const char* find(const char* begin, const char* end) const noexcept { return m_find(*this, begin, end); }
+
+        inline bool contains(char c) const noexcept { return m_table[static_cast<unsigned char>(c)]; }
+
+        /**
+         * @brief Whether @p k is compiled in and supported by the CPU.
+         */
+        static bool supported(kernel k) noexcept;
+
+        /**
+         * @brief Finds like @c find with the given kernel instead of the selected one, so that the kernels can be checked
+         * against each other. Sets larger than @c max_vector_bytes always use the scalar kernel.
+         * @param k A kernel for which @c supported returns true
+         */
+        const char* find_with(kernel k, const char* begin, const char* end) const noexcept;
+    private:
+        typedef const char* (*find_function)(const byte_scanner&, const char*, const char*) noexcept;
+
+        static const char* find_scalar(const byte_scanner& self, const char* begin, const char* end) noexcept;
+        static const char* find_sse2(const byte_scanner& self, const char* begin, const char* end) noexcept;
+        static const char* find_avx2(const byte_scanner& self, const char* begin, const char* end) noexcept;
+
+        static find_function select() noexcept;
+
+        unsigned char m_bytes[max_vector_bytes] = {};
+        std::size_t m_count = 0;
+        bool m_table[256] = {};
+        find_function m_find = find_scalar;
+    };
+
+    /**
+     * @brief ASCII whitespace test equivalent to std::isspace in the "C" locale, without the locale lookup.
+     */
+    constexpr inline bool is_space(char c) noexcept { return c == ' ' || (c >= '\t' && c <= '\r'); }
+}
+
+#endif
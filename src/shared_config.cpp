@@ -0,0 +1,43 @@
+#include "shared_config.hpp"
+#include "mapped_file.h"
+
+#include <limits>
+#include <string>
+#include <utility>
+
+namespace inicpp {
+    INICPP shared_config::shared_config() : shared_config(ini()) {}
+
+    INICPP shared_config::shared_config(ini initial) { publish(std::move(initial)); }
+
+    // Not lock-free with libstdc++, which guards atomic shared_ptr operations with a mutex from a pool; see the class doc
+    INICPP shared_config::snapshot shared_config::load() const noexcept { return std::atomic_load_explicit(&m_current, std::memory_order_acquire); }
+
+    INICPP void shared_config::publish(ini next) { publish(std::make_shared<const ini>(std::move(next))); }
+
+    INICPP void shared_config::publish(snapshot next) {
+        if (!next) next = std::make_shared<const ini>();
+
+        // The pointer is stored before the version is bumped, so a reader that sees the new version also sees the new
+        // snapshot. Like load, the exchange takes the lock the standard library keeps for this shared_ptr.
+        snapshot previous = std::atomic_exchange_explicit(&m_current, std::move(next), std::memory_order_acq_rel);
+        m_version.fetch_add(1, std::memory_order_acq_rel);
+
+        // the previous snapshot is destroyed here, outside of the exchange, unless a reader still holds it
+    }
+
+    INICPP void shared_config::read_file(const std::string& path) {
+        auto const current = load();
+
+        ini next;
+        next.get_comment_handles() = current->get_comment_handles();
+        next.set_delimeter(current->get_delimeter());
+        // Copied rather than mapped: the file is usually rewritten by other processes, and one that truncates it in place
+        // would turn a read of the mapping into SIGBUS
+        std::string text;
+        detail::read_small_file(path, text, std::numeric_limits<std::size_t>::max());
+        next.read(text);
+
+        publish(std::move(next));
+    }
+}
@@ -0,0 +1,91 @@
+#include "thread_pool.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <exception>
+
+namespace inicpp {
+    INICPP thread_pool::thread_pool(std::size_t threads) {
+        if (threads == 0) threads = std::max(1u, std::thread::hardware_concurrency());
+        m_workers.reserve(threads);
+        for (std::size_t i = 0; i < threads; i++) m_workers.emplace_back([this] { run(); });
+    }
+
+    INICPP thread_pool::~thread_pool() {
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_stopping = true;
+        }
+        m_wake.notify_all();
+        for (auto& worker : m_workers) worker.join();
+    }
+
+    INICPP void thread_pool::push(std::function<void()> task) {
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_tasks.push_back(std::move(task));
+        }
+        m_wake.notify_one();
+    }
+
+    INICPP void thread_pool::run_indexed(const std::size_t count, std::function<void(std::size_t)> job) {
+        if (count == 0) return;
+
+        // shared with the workers, since a task may only start after every index has been run; such a late task only
+        // touches count and next
+        struct job_state {
+            std::size_t count = 0;
+            std::function<void(std::size_t)> job;
+            std::atomic<std::size_t> next{ 0 };
+
+            std::mutex mutex;
+            std::condition_variable done;
+            std::size_t finished = 0;
+            std::exception_ptr error;
+        };
+        auto state = std::make_shared<job_state>();
+        state->count = count;
+        state->job = std::move(job);
+
+        // every thread claims indices until none are left
+        auto const work = [state] {
+            for (std::size_t i; (i = state->next.fetch_add(1, std::memory_order_relaxed)) < state->count;) {
+                std::exception_ptr error;
+                try {
+                    state->job(i);
+                } catch (...) {
+                    error = std::current_exception();
+                }
+
+                std::lock_guard<std::mutex> lock(state->mutex);
+                if (error && !state->error) state->error = error;
+                if (++state->finished == state->count) state->done.notify_all();
+            }
+        };
+
+        for (std::size_t i = std::min(size(), count - 1); i > 0; i--) push(work);
+        work();
+        {
+            std::unique_lock<std::mutex> lock(state->mutex);
+            state->done.wait(lock, [&state] { return state->finished == state->count; });
+        }
+
+        // released here rather than by a late task, since it may refer to the caller
+        state->job = nullptr;
+        if (state->error) std::rethrow_exception(state->error);
+    }
+
+    void thread_pool::run() {
+        for (;;) {
+            std::function<void()> task;
+            {
+                std::unique_lock<std::mutex> lock(m_mutex);
+                m_wake.wait(lock, [this] { return m_stopping || !m_tasks.empty(); });
+                if (m_tasks.empty()) return;
+                task = std::move(m_tasks.front());
+                m_tasks.pop_front();
+            }
+            task();
+        }
+    }
+}
@@ -0,0 +1,251 @@
+#ifndef INICPP_TOKENIZER_H
+#define INICPP_TOKENIZER_H 1
+
+#include "parser.hpp"
+#include "parser_exception.hpp"
+#include "comment_matcher.h"
+#include "scanner.h"
+
+#include <cstddef>
+#include <cstring>
+#include <istream>
+#include <string>
+#include <string_view>
+
+namespace inicpp::detail {
+    inline const char* skip_space(const char* cur, const char* const end) noexcept {
+        for (; cur != end && *cur != '\n' && is_space(*cur); ++cur);
+        return cur;
+    }
+
+    inline const char* rskip_space(const char* const begin, const char* cur) noexcept {
+        for (; cur != begin && is_space(cur[-1]); --cur);
+        return cur;
+    }
+
+    inline const char* end_of_line(const char* cur, const char* const end) noexcept {
+        const char* eol = static_cast<const char*>(std::memchr(cur, '\n', end - cur));
+        return eol ? eol : end;
+    }
+
+    inline bool matches(const char* pos, const char* const end, std::string_view token) noexcept {
+        return std::size_t(end - pos) >= token.length() && std::memcmp(pos, token.data(), token.length()) == 0;
+    }
+
+    /**
+     * @brief The INI tokenizer behind @c parse and every @c ini read entry point. The buffer is walked with a vectorized
+     * scanner that jumps straight from one structural byte (newline, bracket, delimiter or comment start) to the next,
+     * and every token is handed to the handler as a view into the buffer.
+     *
+     * The handler is a template parameter, so that @c ini::read binds its callbacks statically; @c parse instantiates it
+     * with the virtual @c parse_handler. A handler provides on_section, on_key_value, on_comment and on_error.
+     */
+    template<typename Handler>
+    class tokenizer {
+    public:
+        template<typename Range>
+        tokenizer(Handler& handler, const Range& comment_handles, std::string_view delim)
+            : m_handler(handler), m_delim(delim), m_comments(comment_handles),
+            m_key_scanner("\n" + std::string(delim.substr(0, 1)) + m_comments.first_bytes()),
+            m_header_scanner("\n]" + m_comments.first_bytes()) {}
+
+        /**
+         * @brief Tokenizes a buffer of complete lines. Consecutive buffers continue the same file.
+         */
+        void buffer(std::string_view buffer) {
+            const char* cur = buffer.data();
+            const char* const end = cur + buffer.length();
+            m_begin = cur;
+
+            while (cur != end) {
+                m_line_number++;
+                const char* const first = skip_space(cur, end);
+
+                const char* eol;
+                if (first == end || *first == '\n') eol = first;
+                else if (*first == '[') eol = header(cur, first, end);
+                else if (m_in_section) eol = key_value(cur, first, end);
+                else if (m_skip_section) eol = skipped(first, end);
+                else eol = preamble(cur, first, end);
+
+                cur = eol == end ? end : eol + 1;
+            }
+            m_offset += buffer.length();
+        }
+
+        // Numbers the lines of the next buffer from @p line + 1 and its bytes from @p offset, for buffers that start in the middle of a file
+        inline void seek(std::size_t line, std::size_t offset) noexcept {
+            m_line_number = line;
+            m_offset = offset;
+        }
+
+        // Number of the last line tokenized
+        inline std::size_t line_number() const noexcept { return m_line_number; }
+    private:
+        const char* header(const char* const line, const char* const first, const char* const end) {
+            // stops at the first ']', comment or end of line after the opening bracket
+            const char* stop = first + 1;
+            for (;; ++stop) {
+                stop = m_header_scanner.find(stop, end);
+                if (stop == end || *stop == '\n' || *stop == ']' || comment_at(stop, end)) break;
+            }
+
+            const char* const name_begin = skip_space(first + 1, stop);
+            const char* const name_end = rskip_space(name_begin, stop);
+
+            if (stop == end || *stop != ']') {
+                // the column follows the name; trailing whitespace is not part of the line, so an empty name at the end of
+                // the line ends right after the '['
+                const char* const name_stop = name_begin == stop && (stop == end || *stop == '\n') ? first + 1 : name_end;
+                return header_error(parse_error_code::unclosed_header, name_stop - line + 1, "Expected ']' before end of line",
+                    first, rskip_space(first, stop), end);
+            } else if (name_begin == name_end) {
+                return header_error(parse_error_code::empty_section_name, first - line + 2,
+                    "Expected valid section name before ']'", first, stop + 1, end);
+            }
+
+            m_handler.on_section(std::string_view(name_begin, name_end - name_begin));
+            m_in_section = true;
+            m_skip_section = false;
+
+            const char* const next = skip_space(stop + 1, end);
+            if (next == end || *next == '\n') return next;
+            if (!comment_at(next, end)) return unexpected(line, next, end);
+            return comment(next, end);
+        }
+
+        const char* key_value(const char* const line, const char* const first, const char* const end) {
+            const char* delim_pos = m_delim.empty() ? first : nullptr;
+
+            // stops at the first comment or end of line, remembering the first delimiter on the way
+            const char* stop = first;
+            for (;; ++stop) {
+                stop = m_key_scanner.find(stop, end);
+                if (stop == end || *stop == '\n' || comment_at(stop, end)) break;
+                if (!delim_pos && matches(stop, end, m_delim)) delim_pos = stop;
+            }
+
+            const bool has_comment = stop != end && *stop != '\n';
+
+            // a comment ends the accessible part of the line as is, the end of line after trimming
+            const char* const accessible_end = has_comment ? stop : rskip_space(first, stop);
+            if (accessible_end == first) return has_comment ? comment(stop, end) : stop;
+
+            if (!delim_pos || std::size_t(accessible_end - delim_pos) < m_delim.length()) {
+                return error(parse_error_code::missing_delimiter, accessible_end - line + 1, "Expected delimeter before end of line",
+                    first, accessible_end, end);
+            }
+
+            const char* const value_begin = skip_space(delim_pos + m_delim.length(), accessible_end);
+            const char* const key_end = rskip_space(first, delim_pos);
+
+            m_handler.on_key_value(std::string_view(first, key_end - first),
+                std::string_view(value_begin, rskip_space(value_begin, accessible_end) - value_begin));
+
+            return has_comment ? comment(stop, end) : stop;
+        }
+
+        const char* preamble(const char* const line, const char* const first, const char* const end) {
+            // only comments may appear before the first section
+            if (!comment_at(first, end)) return unexpected(line, first, end);
+            return comment(first, end);
+        }
+
+        // A line of a section whose header was malformed; comments are still reported, anything else is dropped unchecked
+        inline const char* skipped(const char* const first, const char* const end) {
+            return comment_at(first, end) ? comment(first, end) : end_of_line(first, end);
+        }
+
+        // Reports the comment starting at @p pos, returning the end of its line
+        inline const char* comment(const char* const pos, const char* const end) {
+            const char* const eol = end_of_line(pos, end);
+            m_handler.on_comment(std::string_view(pos, rskip_space(pos, eol) - pos));
+            return eol;
+        }
+
+        // Reports an error in the current line, at [span_begin, span_end); if the handler does not throw, the rest of the line is skipped
+        inline const char* error(parse_error_code code, std::ptrdiff_t column, std::string_view message,
+            const char* const span_begin, const char* const span_end, const char* const end) {
+            m_handler.on_error(parse_error{ m_line_number, static_cast<std::size_t>(column), message, code,
+                m_offset + static_cast<std::size_t>(span_begin - m_begin), static_cast<std::size_t>(span_end - span_begin) });
+            return end_of_line(span_end, end);
+        }
+
+        // Reports a malformed section header; if the handler does not throw, the lines up to the next valid header are dropped
+        inline const char* header_error(parse_error_code code, std::ptrdiff_t column, std::string_view message,
+            const char* const span_begin, const char* const span_end, const char* const end) {
+            m_in_section = false;
+            m_skip_section = true;
+            return error(code, column, message, span_begin, span_end, end);
+        }
+
+        // Reports the text from @p pos to the end of the line, which is not a comment
+        inline const char* unexpected(const char* const line, const char* const pos, const char* const end) {
+            return error(parse_error_code::unexpected_character, pos - line + 1, "Unexpected character",
+                pos, rskip_space(pos, end_of_line(pos, end)), end);
+        }
+
+        inline bool comment_at(const char* pos, const char* end) const noexcept { return m_comments.match(pos, end); }
+
+        Handler& m_handler;
+        std::string m_delim;
+        std::size_t m_line_number = 0;
+        std::size_t m_offset = 0;           // of m_begin, from the start of the text
+        const char* m_begin = nullptr;      // of the buffer being tokenized
+        bool m_in_section = false;
+        bool m_skip_section = false;        // after a malformed header, until the next valid one
+
+        comment_matcher m_comments;
+        byte_scanner m_key_scanner;
+        byte_scanner m_header_scanner;
+    };
+
+    /**
+     * @brief Builds the message of the @c parser_exception thrown for @p error, as "line:column message".
+     */
+    inline std::string format_error(const parse_error& error) {
+        std::string message = std::to_string(error.line) + ":" + std::to_string(error.column) + " ";
+        message.append(error.message);
+        return message;
+    }
+
+    /**
+     * @brief Feeds the rest of @p in to a tokenizer. Complete lines are tokenized straight out of a chunk; a trailing
+     * partial line is carried over to the next one. If a @c parser_exception escapes, the failbit of @p in is set.
+     */
+    template<typename Tokenizer>
+    void read_stream(std::istream& in, Tokenizer& tokens) {
+        if (in.eof()) return;
+
+        std::string chunk(std::size_t(64) * 1024, '\0');
+        std::size_t carry = 0;
+        try {
+            for (;;) {
+                if (carry == chunk.length()) chunk.resize(chunk.length() * 2);
+
+                in.read(&chunk[carry], chunk.length() - carry);
+                std::size_t const filled = carry + static_cast<std::size_t>(in.gcount());
+                if (filled == carry) {
+                    if (carry > 0) tokens.buffer(std::string_view(chunk.data(), carry));
+                    break;
+                }
+
+                std::size_t last_eol = filled;
+                while (last_eol > carry && chunk[last_eol - 1] != '\n') last_eol--;
+                if (last_eol == carry) {
+                    carry = filled;
+                    continue;
+                }
+
+                tokens.buffer(std::string_view(chunk.data(), last_eol));
+                std::memmove(&chunk[0], &chunk[last_eol], filled - last_eol);
+                carry = filled - last_eol;
+            }
+        } catch (const parser_exception&) {
+            in.setstate(std::ios_base::failbit);
+            throw;
+        }
+    }
+}
+
+#endif
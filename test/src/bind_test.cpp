@@ -0,0 +1,96 @@
+#include "check.h"
+
+#include <ini-cpp/ini.hpp>
+#include <ini-cpp/bind.hpp>
+#include <ini-cpp/frozen_ini.hpp>
+
+#include <optional>
+#include <string>
+
+namespace inicpp::test {
+    namespace {
+        struct server_config {
+            std::string host;
+            int port = 0;
+            std::optional<int> timeout;
+        };
+    }
+}
+
+template<>
+struct inicpp::binding<inicpp::test::server_config> {
+    static constexpr inicpp::field_table fields{
+        inicpp::make_field("host", &inicpp::test::server_config::host),
+        inicpp::make_field("port", &inicpp::test::server_config::port),
+        inicpp::make_field("timeout", &inicpp::test::server_config::timeout),
+    };
+};
+
+namespace inicpp::test {
+    namespace {
+        constexpr auto const& server_fields = binding<server_config>::fields;
+
+        // the table is built and searched in constant expressions
+        static_assert(server_fields.size == 3);
+        static_assert(server_fields.find("host") == 0 && server_fields.find("port") == 1 && server_fields.find("timeout") == 2);
+        static_assert(server_fields.find("hostname") == server_fields.size && server_fields.find("") == server_fields.size);
+        static_assert(server_fields.name(1) == "port" && !server_fields.is_optional(1) && server_fields.is_optional(2));
+    }
+
+    void bind_checks() {
+        // a larger table, so that probes run past occupied slots
+        constexpr field_table<server_config, std::string, int, std::optional<int>, int, int> wide{
+            make_field("a", &server_config::host), make_field("b", &server_config::port), make_field("c", &server_config::timeout),
+            make_field("d", &server_config::port), make_field("e", &server_config::port) };
+        for (std::size_t i = 0; i < wide.size; i++) INICPP_CHECK(wide.find(wide.name(i)) == i);
+        INICPP_CHECK(wide.find("f") == wide.size && wide.find("ab") == wide.size);
+
+        ini cfg;
+        cfg.read(std::string(
+            "[server]\nhost=example.org\nport=8080\ntimeout=30\n"
+            "[minimal]\nport=80\nhost=localhost\n"
+            "[broken]\nport=eighty\nextra=1\ntimeout=soon\n"));
+
+        // every field is filled; an optional field is set when its key is there
+        server_config server;
+        bind_result result = bind(cfg["server"], server);
+        INICPP_CHECK(result.ok() && result.missing.empty() && result.unknown.empty() && result.invalid.empty());
+        INICPP_CHECK(server.host == "example.org" && server.port == 8080 && server.timeout == 30);
+
+        // a missing optional field is left empty and not reported
+        server_config minimal = bind<server_config>(cfg["minimal"]);
+        INICPP_CHECK(minimal.host == "localhost" && minimal.port == 80 && !minimal.timeout);
+
+        // missing, unknown and invalid keys are all collected, and invalid values leave their field unchanged
+        server_config broken;
+        broken.port = 1;
+        result = bind(cfg["broken"], broken);
+        INICPP_CHECK(!result);
+        INICPP_CHECK(result.missing == std::vector<std::string>{ "host" });
+        INICPP_CHECK(result.unknown == std::vector<std::string>{ "extra" });
+        INICPP_CHECK((result.invalid == std::vector<std::string>{ "port", "timeout" }));
+        INICPP_CHECK(broken.port == 1 && !broken.timeout);
+
+        // the throwing overload lists all of them in its message and keeps them in the exception
+        std::string message;
+        bind_result thrown;
+        try {
+            bind<server_config>(cfg["broken"]);
+        } catch (const bind_exception& e) {
+            message = e.what();
+            thrown = e.result();
+        }
+        INICPP_CHECK(message == "bind [broken]: missing keys: host; unknown keys: extra; invalid values: port, timeout");
+        INICPP_CHECK(thrown.missing == result.missing && thrown.unknown == result.unknown && thrown.invalid == result.invalid);
+
+        // frozen sections bind the same way
+        const frozen_ini frozen = cfg.freeze();
+        server_config frozen_server = bind<server_config>(frozen["server"]);
+        INICPP_CHECK(frozen_server.host == "example.org" && frozen_server.port == 8080 && frozen_server.timeout == 30);
+
+        server_config frozen_broken;
+        result = bind(frozen["broken"], frozen_broken);
+        INICPP_CHECK(result.missing.size() == 1 && result.unknown.size() == 1 && result.invalid.size() == 2);
+        INICPP_CHECK_THROWS(bind<server_config>(frozen["broken"]), bind_exception);
+    }
+}
@@ -0,0 +1,50 @@
+#ifndef INICPP_TEST_CHECK_H
+#define INICPP_TEST_CHECK_H 1
+
+#include <iostream>
+
+namespace inicpp::test {
+    // Number of failed checks so far
+    inline int& failures() noexcept {
+        static int count = 0;
+        return count;
+    }
+
+    inline void check(bool passed, const char* expression, const char* file, int line) {
+        if (passed) return;
+        failures()++;
+        std::cerr << file << ":" << line << ": check failed: " << expression << "\n";
+    }
+
+    void bind_checks();
+    void comment_matcher_checks();
+    void const_lookup_checks();
+    void conversion_cache_checks();
+    void diagnostics_checks();
+    void file_watcher_checks();
+    void frozen_cache_checks();
+    void key_handle_checks();
+    void load_many_checks();
+    void number_format_checks();
+    void ordered_map_checks();
+    void parse_checks();
+    void parse_stats_checks();
+    void read_parallel_checks();
+    void reload_checks();
+    void scanner_checks();
+    void shared_config_checks();
+    void try_as_checks();
+    void write_file_checks();
+}
+
+// Records a failure if @p expr is false; unlike assert, it is also checked in release builds
+#define INICPP_CHECK(expr) ::inicpp::test::check(static_cast<bool>(expr), #expr, __FILE__, __LINE__)
+
+// Records a failure unless @p expr throws an exception of type @p type
+#define INICPP_CHECK_THROWS(expr, type) do {                                                    \
+        bool thrown_ = false;                                                                   \
+        try { (void)(expr); } catch (const type&) { thrown_ = true; }                           \
+        ::inicpp::test::check(thrown_, #expr " throws " #type, __FILE__, __LINE__);             \
+    } while (false)
+
+#endif
@@ -0,0 +1,79 @@
+#include "check.h"
+
+#include <ini-cpp/parser.hpp>
+
+#include "comment_matcher.h"
+
+#include <random>
+#include <string>
+#include <unordered_set>
+#include <vector>
+
+namespace inicpp::test {
+    namespace {
+        // Whether any non-empty handle starts at @p pos, by comparing each one in turn
+        bool reference_match(const std::vector<std::string>& handles, std::string_view text, std::size_t pos) {
+            for (auto const& handle : handles) {
+                if (!handle.empty() && text.substr(pos, handle.length()) == handle) return true;
+            }
+            return false;
+        }
+
+        // The keys and comments of @p text, tokenized with @p handles
+        std::vector<std::string> tokens(const std::string& text, std::unordered_set<std::string> handles) {
+            struct recorder : parse_handler {
+                std::vector<std::string> events;
+                void on_key_value(std::string_view key, std::string_view value) override { events.push_back(std::string(key) + "=" + std::string(value)); }
+                void on_comment(std::string_view comment) override { events.push_back(std::string(comment)); }
+            } r;
+            parse_options options;
+            options.comment_handles = std::move(handles);
+            parse(text, r, options);
+            return r.events;
+        }
+    }
+
+    void comment_matcher_checks() {
+        using detail::comment_matcher;
+
+        // shared prefixes, multi-byte handles, bytes with the high bit set and an empty handle
+        std::vector<std::vector<std::string>> const sets = {
+            {}, { "" }, { ";" }, { "#", "##" }, { "##", "#" }, { "/", "//" }, { "//", "#", ";" },
+            { "--", "-->", "<!--" }, { "REM", "RE", "R" }, { "\xc2\xa7", "\xc2\xb6", "\xe2\x80\xa2" }, { "ab", "abc", "b", "", "ca" },
+        };
+
+        std::mt19937 random(4321);
+        for (auto const& handles : sets) {
+            comment_matcher const matcher(handles);
+
+            // the first bytes are the distinct first bytes of the non-empty handles
+            std::string expected_first;
+            for (auto const& handle : handles) {
+                if (!handle.empty() && expected_first.find(handle[0]) == std::string::npos) expected_first += handle[0];
+            }
+            INICPP_CHECK(matcher.first_bytes().length() == expected_first.length());
+            for (char c : expected_first) INICPP_CHECK(matcher.first_bytes().find(c) != std::string::npos);
+
+            // every position of random text over the bytes of the handles, including positions near the end
+            std::string alphabet = "x ";
+            for (auto const& handle : handles) alphabet += handle;
+            for (int round = 0; round < 200; round++) {
+                std::string text(random() % 12, '\0');
+                for (char& c : text) c = alphabet[random() % alphabet.length()];
+                for (std::size_t pos = 0; pos <= text.length(); pos++)
+                    INICPP_CHECK(matcher.match(text.data() + pos, text.data() + text.length()) == reference_match(handles, text, pos));
+            }
+        }
+
+        // how the handles split lines when parsing
+        INICPP_CHECK((tokens("[a]\nk=v#1##2\n##c\n", { "#", "##" }) == std::vector<std::string>{ "k=v", "#1##2", "##c" }));
+        INICPP_CHECK((tokens("[a]\nk=v#1##2\n##c\n", { "##" }) == std::vector<std::string>{ "k=v#1", "##2", "##c" }));
+        INICPP_CHECK((tokens("[a]\nurl=http://host/path\n/ note\n", { "/", "//" }) == std::vector<std::string>{ "url=http:", "//host/path", "/ note" }));
+        INICPP_CHECK((tokens("[a]\nurl=http://host/path\n// note\n", { "//" }) == std::vector<std::string>{ "url=http:", "//host/path", "// note" }));
+        INICPP_CHECK((tokens("[a]\nk=a<!-b<!--c\n", { "<!--" }) == std::vector<std::string>{ "k=a<!-b", "<!--c" }));
+
+        // without handles, nothing is a comment
+        INICPP_CHECK((tokens("[a]\nk=v;x#y//z\n", {}) == std::vector<std::string>{ "k=v;x#y//z" }));
+        INICPP_CHECK((tokens("[a]\nk=v;x\n", { "" }) == std::vector<std::string>{ "k=v;x" }));
+    }
+}
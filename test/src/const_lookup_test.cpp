@@ -0,0 +1,56 @@
+#include "check.h"
+
+#include <ini-cpp/ini.hpp>
+
+#include <string>
+#include <vector>
+
+namespace inicpp::test {
+    namespace {
+        // The sections of @p cfg, and the keys of each, in iteration order
+        std::vector<std::string> layout(const ini& cfg) {
+            std::vector<std::string> names;
+            for (const ini_section& section : cfg) {
+                names.push_back(section.get_name());
+                for (const auto& entry : section) names.push_back(section.get_name() + "." + entry.first);
+            }
+            return names;
+        }
+    }
+
+    void const_lookup_checks() {
+        ini mutable_cfg;
+        mutable_cfg.read(std::string("[a]\nk=1\nj=2\n[b]\nk=3\n"));
+        const ini& cfg = mutable_cfg;
+        std::vector<std::string> const before = layout(cfg);
+
+        // a missing section is the shared invalid section, whatever its name
+        const ini_section& missing = cfg["nope"];
+        INICPP_CHECK(&missing == &cfg["other"] && &missing == &cfg.find("nope"));
+        INICPP_CHECK(missing.begin() == missing.end() && !missing.contains("k"));
+        INICPP_CHECK(!cfg.contains("nope") && cfg.try_get("nope") == nullptr);
+
+        // a missing key is the shared invalid value, in an existing section or in the missing one
+        const ini_value& missing_value = cfg["a"]["nope"];
+        INICPP_CHECK(!missing_value);
+        INICPP_CHECK(&missing_value == &cfg["b"]["x"] && &missing_value == &cfg["nope"]["k"] && &missing_value == &cfg["a"].find("nope"));
+        INICPP_CHECK(!cfg["a"].contains("nope") && cfg["a"].try_get("nope") == nullptr);
+
+        // iteration is unchanged, through the const and the mutable ini
+        INICPP_CHECK(layout(cfg) == before);
+        INICPP_CHECK(layout(mutable_cfg) == before);
+
+        // hits still find the real entries
+        INICPP_CHECK(&cfg["a"] == cfg.try_get("a") && &cfg["a"]["k"] == cfg["a"].try_get("k"));
+        INICPP_CHECK(cfg["b"]["k"].as<int>() == 3);
+
+        // the shared objects stay empty after the ini they were looked up in is gone
+        {
+            ini other;
+            other.read(std::string("[a]\nk=1\n"));
+            const ini& const_other = other;
+            INICPP_CHECK(&const_other["nope"] == &missing && &const_other["a"]["nope"] == &missing_value);
+        }
+        INICPP_CHECK(!cfg["nope"]["k"] && cfg["nope"].begin() == cfg["nope"].end());
+    }
+}
@@ -0,0 +1,74 @@
+#include "check.h"
+
+#include <ini-cpp/ini.hpp>
+
+#include <atomic>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace inicpp::test {
+    void conversion_cache_checks() {
+        ini config;
+        config.read(std::string("[s]\na=42\nd=2.5\nn=-7\n"));
+
+        // a cached conversion is only reused for the same type and the same text
+        ini_value& a = config["s"]["a"];
+        INICPP_CHECK(a.as<int>() == 42 && a.as<int>() == 42);
+        INICPP_CHECK(a.as<double>() == 42.0 && a.as<int>() == 42);
+        a = 13;
+        INICPP_CHECK(a.as<int>() == 13);
+        a.set_value("99");
+        INICPP_CHECK(a.as<long>() == 99 && a.as<long>() == 99);
+        INICPP_CHECK(config["s"]["n"].as<short>() == -7 && config["s"]["n"].as<long long>() == -7);
+        INICPP_CHECK(config["s"]["d"].as<float>() == 2.5f && config["s"]["d"].as<double>() == 2.5);
+
+        // reading and reloading replace the cached values
+        config.read(std::string("[s]\na=5\n"));
+        INICPP_CHECK(config["s"]["a"].as<long>() == 5);
+        config.reload("[s]\na=8\n");
+        INICPP_CHECK(config["s"]["a"].as<long>() == 8);
+
+        // a copy has its own cache
+        ini_value copy = config["s"]["a"];
+        copy.set_value("6");
+        INICPP_CHECK(copy.as<long>() == 6 && config["s"]["a"].as<long>() == 8);
+
+        // failed conversions are not cached
+        config["s"]["x"] = "nope";
+        INICPP_CHECK_THROWS(config["s"]["x"].as<int>(), std::invalid_argument);
+        INICPP_CHECK_THROWS(config["s"]["x"].as<int>(), std::invalid_argument);
+
+        // concurrent readers converting the same values to different types
+        ini shared;
+        std::string text = "[s]\n";
+        for (int k = 0; k < 64; k++) text += "k" + std::to_string(k) + "=" + std::to_string(k * 1000 + 1) + "\n";
+        shared.read(text);
+
+        const ini& readers = shared;
+        std::vector<const ini_value*> values;
+        for (int k = 0; k < 64; k++) values.push_back(&readers["s"]["k" + std::to_string(k)]);
+
+        std::atomic<int> wrong{ 0 };
+        std::vector<std::thread> threads;
+        for (int t = 0; t < 4; t++) {
+            threads.emplace_back([&values, &wrong, t] {
+                for (int r = 0; r < 20000; r++) {
+                    int const k = (r * 7 + t) % 64, expected = k * 1000 + 1;
+                    const ini_value& value = *values[k];
+                    bool right = true;
+                    switch ((r + t) % 4) {
+                    case 0: right = value.as<int>() == expected; break;
+                    case 1: right = value.as<double>() == expected; break;
+                    case 2: right = value.as<unsigned long>() == static_cast<unsigned long>(expected); break;
+                    default: right = value.as<float>() == static_cast<float>(expected); break;
+                    }
+                    if (!right) wrong++;
+                }
+            });
+        }
+        for (auto& thread : threads) thread.join();
+        INICPP_CHECK(wrong == 0);
+    }
+}
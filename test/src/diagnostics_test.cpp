@@ -0,0 +1,85 @@
+#include "check.h"
+
+#include <ini-cpp/ini.hpp>
+#include <ini-cpp/parser.hpp>
+#include <ini-cpp/parser_exception.hpp>
+
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace inicpp::test {
+    namespace {
+        // The text an error points at
+        std::string span(const std::string& text, const parse_error& error) { return text.substr(error.offset, error.length); }
+    }
+
+    void diagnostics_checks() {
+        const std::string text =
+            "junk before\n"
+            "[a]\n"
+            "x=1\n"
+            "novalue\n"
+            "[b\n"
+            "y=2\n"
+            "[  ]\n"
+            "[c] trailing ; c\n"
+            "z=3 ; ok\n";
+
+        // every error is collected, with its line, code and the text it points at
+        ini config;
+        std::vector<parse_error> errors;
+        INICPP_CHECK(!config.read(text, errors));
+        INICPP_CHECK(errors.size() == 5);
+        if (errors.size() == 5) {
+            INICPP_CHECK(errors[0].line == 1 && errors[0].code == parse_error_code::unexpected_character && span(text, errors[0]) == "junk before");
+            INICPP_CHECK(errors[1].line == 4 && errors[1].code == parse_error_code::missing_delimiter && span(text, errors[1]) == "novalue");
+            INICPP_CHECK(errors[2].line == 5 && errors[2].code == parse_error_code::unclosed_header && span(text, errors[2]) == "[b");
+            INICPP_CHECK(errors[3].line == 7 && errors[3].code == parse_error_code::empty_section_name && span(text, errors[3]) == "[  ]");
+            INICPP_CHECK(errors[4].line == 8 && errors[4].code == parse_error_code::unexpected_character && span(text, errors[4]) == "trailing ; c");
+        }
+
+        // the lines around the errors are still read; keys after a bad header are dropped up to the next valid one
+        INICPP_CHECK(config["a"]["x"].as<int>() == 1);
+        INICPP_CHECK(!config["a"].contains("y"));
+        INICPP_CHECK(!config.contains("b"));
+        INICPP_CHECK(config["c"]["z"].as<int>() == 3);
+
+        // a key after a bad header does not overwrite the key of the section before it
+        ini overwritten;
+        std::vector<parse_error> header_errors;
+        INICPP_CHECK(!overwritten.read(std::string("[a]\nport=80\n[db\nport=5432\n"), header_errors));
+        INICPP_CHECK(header_errors.size() == 1 && header_errors[0].code == parse_error_code::unclosed_header);
+        INICPP_CHECK(overwritten["a"]["port"].as<int>() == 80);
+
+        // without a section before it, the dropped lines report nothing either, not even a missing delimiter
+        ini orphaned;
+        std::vector<parse_error> orphan_errors;
+        INICPP_CHECK(!orphaned.read(std::string("[db\nport=5432\nnovalue\n; note\n[c]\nk=v\n"), orphan_errors));
+        INICPP_CHECK(orphan_errors.size() == 1 && orphan_errors[0].line == 1);
+        INICPP_CHECK(!orphaned.contains("db") && orphaned["c"]["k"].as<const std::string&>() == "v");
+
+        // the first error reads as the exception a plain read throws
+        std::string thrown;
+        try {
+            ini().read(text);
+        } catch (const parser_exception& e) {
+            thrown = e.what();
+        }
+        INICPP_CHECK(!errors.empty() && to_string(errors[0]) == thrown);
+
+        // offsets count from the start of a stream, across the chunks it is read in
+        std::string large;
+        for (int i = 0; i < 20000; i++) large += "[s" + std::to_string(i) + "]\nk=v\n";
+        large += "bad line\n";
+        std::istringstream in(large);
+        std::vector<parse_error> stream_errors;
+        INICPP_CHECK(!ini().read(in, stream_errors));
+        INICPP_CHECK(stream_errors.size() == 1);
+        if (stream_errors.size() == 1) INICPP_CHECK(stream_errors[0].line == 40001 && span(large, stream_errors[0]) == "bad line");
+
+        // a clean text reports no errors
+        std::vector<parse_error> none;
+        INICPP_CHECK(ini().read(std::string("[a]\nx=1\n"), none) && none.empty());
+    }
+}
@@ -0,0 +1,124 @@
+#include "check.h"
+
+#include <ini-cpp/file_watcher.hpp>
+#include <ini-cpp/parser_exception.hpp>
+
+#include <chrono>
+#include <condition_variable>
+#include <exception>
+#include <filesystem>
+#include <fstream>
+#include <mutex>
+#include <string>
+
+namespace inicpp::test {
+    namespace {
+        void write(const std::filesystem::path& path, const std::string& text) {
+            std::ofstream out(path, std::ios::binary | std::ios::trunc);
+            out << text;
+        }
+
+        // Latest value of [a] k seen by a subscriber
+        struct seen_value {
+            std::mutex mutex;
+            std::condition_variable changed;
+            int value = -1;
+            int calls = 0;
+
+            void operator()(const shared_config::snapshot& snapshot) {
+                std::lock_guard<std::mutex> lock(mutex);
+                value = (*snapshot)["a"]["k"].as<int>();
+                calls++;
+                changed.notify_all();
+            }
+
+            // Waits until a subscriber has seen @p expected
+            bool wait_for(int expected) {
+                std::unique_lock<std::mutex> lock(mutex);
+                return changed.wait_for(lock, std::chrono::seconds(10), [&] { return value == expected; });
+            }
+        };
+
+        // Checks that the watcher thread picks up a rewrite of @p path on its own
+        void check_background(const std::filesystem::path& path, watch_options options) {
+            write(path, "[a]\nk=1\n");
+            options.debounce = std::chrono::milliseconds(10);
+            file_watcher watcher(path.string(), options);
+            seen_value seen;
+            watcher.subscribe([&seen](const shared_config::snapshot& snapshot) { seen(snapshot); });
+
+            write(path, "[a]\nk=2\n");
+            INICPP_CHECK(seen.wait_for(2));
+            INICPP_CHECK((*watcher.load())["a"]["k"].as<int>() == 2);
+        }
+    }
+
+    void file_watcher_checks() {
+        std::filesystem::path const directory = std::filesystem::temp_directory_path() / "ini-cpp-file-watcher-test";
+        std::filesystem::create_directories(directory);
+        std::filesystem::path const path = directory / "watched.ini";
+        write(path, "[a]\nk=1\n");
+
+        // a watcher that only checks when asked to, so that the checks below do not race with its thread
+        watch_options manual;
+        manual.force_polling = true;
+        manual.poll_interval = std::chrono::hours(1);
+        {
+            file_watcher watcher(path.string(), manual);
+            INICPP_CHECK((*watcher.load())["a"]["k"].as<int>() == 1);
+            INICPP_CHECK(watcher.parse_count() == 1);
+
+            seen_value seen;
+            watcher.subscribe([&seen](const shared_config::snapshot& snapshot) { seen(snapshot); });
+            int errors = 0;
+            bool parse_failure = false;
+            watcher.set_error_handler([&](std::exception_ptr error) {
+                errors++;
+                try {
+                    std::rethrow_exception(error);
+                } catch (const parser_exception&) {
+                    parse_failure = true;
+                } catch (...) {
+                }
+            });
+
+            // a change is published and handed to subscribers
+            write(path, "[a]\nk=2\n");
+            INICPP_CHECK(watcher.check());
+            INICPP_CHECK(seen.value == 2 && seen.calls == 1);
+            INICPP_CHECK((*watcher.load())["a"]["k"].as<int>() == 2);
+            INICPP_CHECK(watcher.parse_count() == 2);
+
+            // the same content is not parsed again
+            write(path, "[a]\nk=2\n");
+            INICPP_CHECK(!watcher.check());
+            INICPP_CHECK(watcher.parse_count() == 2 && seen.calls == 1);
+
+            // a version that fails to parse is reported once and the previous one stays published
+            write(path, "[a]\nk=3\nbroken\n");
+            INICPP_CHECK(!watcher.check());
+            INICPP_CHECK(errors == 1 && parse_failure);
+            INICPP_CHECK((*watcher.load())["a"]["k"].as<int>() == 2);
+            INICPP_CHECK(!watcher.check());
+            INICPP_CHECK(errors == 1 && watcher.parse_count() == 3);
+
+            // a file that cannot be read is reported as well
+            std::filesystem::remove(path);
+            INICPP_CHECK(!watcher.check());
+            INICPP_CHECK(errors == 2);
+
+            write(path, "[a]\nk=4\n");
+            INICPP_CHECK(watcher.check() && seen.value == 4);
+        }
+
+        // the watcher thread notices changes, through notifications and through polling
+        check_background(path, watch_options());
+        watch_options polling;
+        polling.force_polling = true;
+        polling.poll_interval = std::chrono::milliseconds(20);
+        check_background(path, polling);
+
+        std::error_code ec;
+        std::filesystem::remove_all(directory, ec);
+    }
+}
@@ -0,0 +1,152 @@
+#include "check.h"
+
+#include <ini-cpp/detail/frozen_layout.h>
+#include <ini-cpp/frozen_ini.hpp>
+#include <ini-cpp/ini.hpp>
+#include <ini-cpp/parser_exception.hpp>
+
+#include "hash.h"
+
+#include <chrono>
+#include <cstddef>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <string>
+
+namespace inicpp::test {
+    namespace {
+        std::string read_bytes(const std::filesystem::path& path) {
+            std::ifstream in(path, std::ios::binary);
+            return std::string(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+        }
+
+        void write_bytes(const std::filesystem::path& path, const std::string& bytes) {
+            std::ofstream out(path, std::ios::binary | std::ios::trunc);
+            out << bytes;
+        }
+
+        // Recomputes both checksums of a compiled file, so that only the layout checks can reject it
+        void reseal(std::string& file) {
+            detail::frozen_file_header header;
+            std::memcpy(&header, file.data(), sizeof(header));
+            header.checksum = detail::hash_bytes(std::string_view(file.data() + sizeof(header), file.size() - sizeof(header)));
+            header.header_checksum = detail::hash_bytes(std::string_view(reinterpret_cast<const char*>(&header), offsetof(detail::frozen_file_header, header_checksum)));
+            std::memcpy(file.data(), &header, sizeof(header));
+        }
+
+        // Marks @p path as written an hour ago, so that a rewrite shows in its time stamp
+        void age(const std::filesystem::path& path) {
+            std::filesystem::last_write_time(path, std::filesystem::file_time_type::clock::now() - std::chrono::hours(1));
+        }
+
+        bool rewritten(const std::filesystem::path& path) {
+            return std::filesystem::last_write_time(path) > std::filesystem::file_time_type::clock::now() - std::chrono::minutes(30);
+        }
+
+        bool loads(const std::filesystem::path& path) {
+            try {
+                return !frozen_ini::load_binary(path.string()).empty();
+            } catch (const parser_exception&) {
+                return false;
+            }
+        }
+    }
+
+    void frozen_cache_checks() {
+        std::filesystem::path const directory = std::filesystem::temp_directory_path() / "ini-cpp-frozen-cache-test";
+        std::filesystem::create_directories(directory);
+        std::filesystem::path const source = directory / "app.ini";
+        std::filesystem::path const cache = directory / "app.ini.bin";
+        std::filesystem::remove(cache);
+
+        write_bytes(source, "[a]\nx=1\ny=two\n[b]\nz=3\n");
+
+        // a missing cache is written on the first read and mapped on the next
+        frozen_ini first = frozen_ini::read_file_cached(source.string(), cache.string());
+        INICPP_CHECK(first["a"]["y"].as<std::string>() == "two" && first["b"]["z"].as<int>() == 3);
+        INICPP_CHECK(loads(cache));
+        age(cache);
+        frozen_ini hit = frozen_ini::read_file_cached(source.string(), cache.string());
+        INICPP_CHECK(!rewritten(cache));
+        INICPP_CHECK(hit["a"]["x"].as<int>() == 1 && hit["b"]["z"].as<int>() == 3);
+
+        // save_binary and load_binary round trip, from a frozen_ini and from an ini
+        ini config;
+        config.read_file(source.string());
+        std::filesystem::path const saved = directory / "saved.bin";
+        config.save_binary(saved.string());
+        frozen_ini const loaded = frozen_ini::load_binary(saved.string());
+        INICPP_CHECK(loaded.size() == 2 && loaded["a"]["y"].as<std::string>() == "two");
+        ini copied;
+        copied.load_binary(saved.string());
+        std::string expected, actual;
+        config.write(expected);
+        copied.write(actual);
+        INICPP_CHECK(expected == actual);
+
+        // damaged caches are rejected by load_binary, and read_file_cached parses the text and writes a good cache
+        std::string const good = read_bytes(cache);
+        std::size_t const blob = sizeof(detail::frozen_file_header);
+        auto const rejected = [&](std::string damaged) {
+            write_bytes(cache, damaged);
+            bool const refused = !loads(cache);
+            age(cache);
+            frozen_ini const fallback = frozen_ini::read_file_cached(source.string(), cache.string());
+            bool const recovered = fallback["a"]["y"].as<std::string>() == "two" && fallback["b"]["z"].as<int>() == 3;
+            return refused && recovered && rewritten(cache) && read_bytes(cache) == good;
+        };
+
+        INICPP_CHECK(rejected(good.substr(0, good.size() - 1)));
+        INICPP_CHECK(rejected(good.substr(0, blob / 2)));
+        INICPP_CHECK(rejected(""));
+
+        std::string flipped = good;
+        flipped[blob + 20] ^= 0x40;
+        INICPP_CHECK(rejected(flipped));
+
+        std::string bad_header = good;
+        bad_header[8] ^= 0x01;
+        INICPP_CHECK(rejected(bad_header));
+
+        // offsets past the end of the blob, under valid checksums
+        for (std::size_t field : { offsetof(detail::frozen_header, sections), offsetof(detail::frozen_header, keys),
+            offsetof(detail::frozen_header, strings), offsetof(detail::frozen_header, section_table) + offsetof(detail::frozen_table, slots) }) {
+            std::string out_of_range = good;
+            std::uint32_t const offset = 0x7ffffff0u;
+            std::memcpy(&out_of_range[blob + field], &offset, sizeof(offset));
+            reseal(out_of_range);
+            INICPP_CHECK(rejected(out_of_range));
+        }
+
+        // a name that runs past the end of the blob
+        {
+            std::string long_name = good;
+            detail::frozen_header header;
+            std::memcpy(&header, long_name.data() + blob, sizeof(header));
+            std::uint32_t const length = 0x10000u;
+            std::memcpy(&long_name[blob + header.sections + offsetof(detail::frozen_section, name_length)], &length, sizeof(length));
+            reseal(long_name);
+            INICPP_CHECK(rejected(long_name));
+        }
+
+        // a stale cache is parsed again and rewritten, then hit
+        write_bytes(source, "[a]\nx=10\n");
+        age(cache);
+        frozen_ini const fresh = frozen_ini::read_file_cached(source.string(), cache.string());
+        INICPP_CHECK(fresh["a"]["x"].as<int>() == 10 && !fresh.contains("b"));
+        INICPP_CHECK(rewritten(cache));
+        age(cache);
+        INICPP_CHECK(frozen_ini::read_file_cached(source.string(), cache.string())["a"]["x"].as<int>() == 10);
+        INICPP_CHECK(!rewritten(cache));
+
+        // the ini overload goes through the same cache
+        ini through_cache;
+        through_cache.read_file_cached(source.string(), cache.string());
+        INICPP_CHECK(through_cache["a"]["x"].as<int>() == 10);
+
+        std::error_code ec;
+        std::filesystem::remove_all(directory, ec);
+    }
+}
@@ -0,0 +1,173 @@
+#include "check.h"
+
+#include <ini-cpp/ini.hpp>
+
+#include <string>
+#include <utility>
+
+namespace inicpp::test {
+    namespace {
+        // A document with the keys a.k=1, a.j=2 and b.k=3
+        ini sample() {
+            ini cfg;
+            cfg.read(std::string("[a]\nk=1\nj=2\n[b]\nk=3\n"));
+            return cfg;
+        }
+
+        // Whether @p handle resolves to the same value as a lookup by name
+        bool resolves_like_lookup(ini& cfg, key_handle& handle) {
+            return cfg.try_get(handle) == (cfg.try_get(handle.section()) ? cfg.try_get(handle.section())->try_get(handle.key()) : nullptr);
+        }
+    }
+
+    void key_handle_checks() {
+        // a handle resolves to the value of its key, and again to the same one
+        {
+            ini cfg = sample();
+            key_handle handle = cfg.handle("a", "k");
+            INICPP_CHECK(cfg.try_get(handle) == &cfg["a"]["k"]);
+            INICPP_CHECK(cfg.try_get(handle) == &cfg["a"]["k"]);
+            INICPP_CHECK(handle.section() == "a" && handle.key() == "k");
+        }
+
+        // adding sections and keys does not move the values a handle points at
+        {
+            ini cfg = sample();
+            key_handle handle = cfg.handle("a", "k");
+            const ini_value* const before = cfg.try_get(handle);
+            for (int i = 0; i < 1000; i++) {
+                cfg["s" + std::to_string(i)]["k"] = i;
+                cfg["a"]["k" + std::to_string(i)] = i;
+            }
+            INICPP_CHECK(cfg.try_get(handle) == before && before == &cfg["a"]["k"]);
+        }
+
+        // a miss is not remembered, so the key is found once it is added
+        {
+            ini cfg = sample();
+            key_handle missing_key = cfg.handle("a", "x");
+            key_handle missing_section = cfg.handle("c", "k");
+            INICPP_CHECK(cfg.try_get(missing_key) == nullptr);
+            INICPP_CHECK(cfg.try_get(missing_section) == nullptr);
+            cfg["a"]["x"] = 4;
+            INICPP_CHECK(cfg.try_get(missing_key) == &cfg["a"]["x"]);
+            cfg.read(std::string("[a]\nk=1\n[c]\nk=5\n"));
+            INICPP_CHECK(cfg.try_get(missing_section) && cfg.try_get(missing_section)->as<int>() == 5);
+        }
+
+        // removing a key of a section
+        {
+            ini cfg = sample();
+            key_handle handle = cfg.handle("a", "k");
+            cfg["a"].remove("k");
+            INICPP_CHECK(cfg.try_get(handle) == nullptr);
+        }
+
+        // clearing a section
+        {
+            ini cfg = sample();
+            key_handle handle = cfg.handle("a", "k");
+            cfg["a"].clear();
+            INICPP_CHECK(cfg.try_get(handle) == nullptr);
+        }
+
+        // renaming a section
+        {
+            ini cfg = sample();
+            key_handle old_name = cfg.handle("a", "k");
+            key_handle new_name = cfg.handle("c", "k");
+            cfg["a"].set_name("c");
+            INICPP_CHECK(cfg.try_get(old_name) == nullptr);
+            INICPP_CHECK(cfg.try_get(new_name) && cfg.try_get(new_name)->as<int>() == 1);
+        }
+
+        // assigning over a section, by copy and by move
+        {
+            ini cfg = sample();
+            key_handle handle = cfg.handle("a", "k");
+            key_handle dropped = cfg.handle("a", "j");
+            ini other;
+            other.read(std::string("[a]\nk=3\n"));
+            cfg["a"] = other["a"];
+            INICPP_CHECK(resolves_like_lookup(cfg, handle) && cfg.try_get(handle)->as<int>() == 3);
+            INICPP_CHECK(cfg.try_get(dropped) == nullptr);
+
+            ini moved_from;
+            moved_from.read(std::string("[a]\nz=1\n"));
+            cfg["a"] = std::move(moved_from["a"]);
+            INICPP_CHECK(cfg.try_get(handle) == nullptr);
+        }
+
+        // removing a section
+        {
+            ini cfg = sample();
+            key_handle handle = cfg.handle("a", "k");
+            INICPP_CHECK(cfg.remove("a"));
+            INICPP_CHECK(cfg.try_get(handle) == nullptr);
+        }
+
+        // clearing the ini
+        {
+            ini cfg = sample();
+            key_handle handle = cfg.handle("b", "k");
+            cfg.clear();
+            INICPP_CHECK(cfg.try_get(handle) == nullptr);
+        }
+
+        // move-assigning the ini
+        {
+            ini cfg = sample();
+            key_handle handle = cfg.handle("a", "k");
+            key_handle kept = cfg.handle("b", "k");
+            ini other;
+            other.read(std::string("[b]\nk=6\n"));
+            cfg = std::move(other);
+            INICPP_CHECK(cfg.try_get(handle) == nullptr);
+            INICPP_CHECK(resolves_like_lookup(cfg, kept) && cfg.try_get(kept)->as<int>() == 6);
+        }
+
+        // reading into the ini
+        {
+            ini cfg = sample();
+            key_handle handle = cfg.handle("a", "k");
+            cfg.read(std::string("[a]\nk=7\n"));
+            INICPP_CHECK(resolves_like_lookup(cfg, handle) && cfg.try_get(handle)->as<int>() == 7);
+        }
+
+        // reloading, which replaces changed sections and drops those that are gone
+        {
+            ini cfg;
+            cfg.reload(std::string("[a]\nk=1\n[b]\nk=3\n"));
+            key_handle changed = cfg.handle("a", "k");
+            key_handle gone = cfg.handle("b", "k");
+            cfg.reload(std::string("[a]\nk=8\n"));
+            INICPP_CHECK(resolves_like_lookup(cfg, changed) && cfg.try_get(changed)->as<int>() == 8);
+            INICPP_CHECK(cfg.try_get(gone) == nullptr);
+        }
+
+        // a handle resolved against one ini finds the key in a copy or a moved-to ini, not in the original
+        {
+            ini cfg = sample();
+            key_handle handle = cfg.handle("a", "k");
+            const ini_value* const original = cfg.try_get(handle);
+
+            ini copy = cfg;
+            INICPP_CHECK(copy.try_get(handle) == &copy["a"]["k"] && copy.try_get(handle) != original);
+            INICPP_CHECK(cfg.try_get(handle) == original);
+
+            ini moved(std::move(copy));
+            INICPP_CHECK(moved.try_get(handle) == &moved["a"]["k"]);
+
+            ini assigned;
+            assigned = cfg;
+            INICPP_CHECK(assigned.try_get(handle) == &assigned["a"]["k"] && assigned.try_get(handle) != original);
+        }
+
+        // a const ini resolves handles as well
+        {
+            const ini cfg = sample();
+            key_handle handle = cfg.handle("b", "k");
+            INICPP_CHECK(cfg.try_get(handle) && cfg.try_get(handle)->as<int>() == 3);
+        }
+    }
+}
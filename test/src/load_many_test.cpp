@@ -0,0 +1,90 @@
+#include "check.h"
+
+#include <ini-cpp/load_many.hpp>
+#include <ini-cpp/parser_exception.hpp>
+#include <ini-cpp/thread_pool.hpp>
+
+#include <atomic>
+#include <filesystem>
+#include <fstream>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+#include <vector>
+
+namespace inicpp::test {
+    namespace {
+        // Whether @p result failed with an exception of type E
+        template<typename E>
+        bool failed_with(const load_result& result) {
+            try {
+                result.rethrow();
+            } catch (const E&) {
+                return true;
+            } catch (...) {
+            }
+            return false;
+        }
+    }
+
+    void load_many_checks() {
+        thread_pool pool(3);
+
+        // every index is run once, and the first exception is rethrown after all of them
+        std::vector<std::atomic<int>> runs(100);
+        pool.run_indexed(runs.size(), [&runs](std::size_t i) { runs[i]++; });
+        bool once = true;
+        for (auto const& count : runs) once = once && count == 1;
+        INICPP_CHECK(once);
+
+        std::atomic<int> finished{ 0 };
+        INICPP_CHECK_THROWS(pool.run_indexed(50, [&finished](std::size_t i) {
+            finished++;
+            if (i == 10) throw std::runtime_error("job");
+        }), std::runtime_error);
+        INICPP_CHECK(finished == 50);
+
+        std::filesystem::path const directory = std::filesystem::temp_directory_path() / "ini-cpp-load-many-test";
+        std::filesystem::create_directories(directory);
+
+        std::vector<std::string> paths;
+        for (int i = 0; i < 40; i++) {
+            std::filesystem::path const path = directory / ("file" + std::to_string(i) + ".ini");
+            std::ofstream out(path, std::ios::binary);
+            out << "[file]\nid=" << i << "\n[more]\nk=v" << i << "\n";
+            if (i == 7) out << "broken line\n";
+            paths.push_back(path.string());
+        }
+        paths.push_back((directory / "missing.ini").string());
+
+        for (std::size_t arena : { std::size_t(0), std::size_t(256) }) {
+            load_options options;
+            options.shared_arena_size = arena;
+            std::vector<load_result> results = load_many(paths, pool, options);
+            INICPP_CHECK(results.size() == paths.size());
+            if (results.size() != paths.size()) continue;
+
+            // results come back in the order of the paths, and one failure does not stop the others
+            for (int i = 0; i < 40; i++) {
+                if (i == 7) continue;
+                INICPP_CHECK(results[i] && results[i].document["file"]["id"].as<int>() == i);
+                INICPP_CHECK(results[i].document["more"]["k"].as<std::string>() == "v" + std::to_string(i));
+            }
+
+            // a parse error keeps the sections before it, a missing file is a system error
+            INICPP_CHECK(!results[7] && failed_with<parser_exception>(results[7]));
+            INICPP_CHECK(results[7].document["file"]["id"].as<int>() == 7);
+            INICPP_CHECK(!results[40] && failed_with<std::system_error>(results[40]));
+            INICPP_CHECK(results[40].document.empty());
+
+            // documents outlive the call and stay writable
+            results[0].document["file"]["id"] = 100;
+            INICPP_CHECK(results[0].document["file"]["id"].as<int>() == 100);
+        }
+
+        INICPP_CHECK(load_many({}, pool).empty());
+
+        std::error_code ec;
+        std::filesystem::remove_all(directory, ec);
+    }
+}
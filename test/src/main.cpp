@@ -1,8 +1,29 @@
 #include <iostream>
 #include <ini-cpp/ini.hpp>
 #include <fstream>
+#include "check.h"
 
 int main() {
+    inicpp::test::bind_checks();
+    inicpp::test::comment_matcher_checks();
+    inicpp::test::const_lookup_checks();
+    inicpp::test::conversion_cache_checks();
+    inicpp::test::diagnostics_checks();
+    inicpp::test::file_watcher_checks();
+    inicpp::test::frozen_cache_checks();
+    inicpp::test::key_handle_checks();
+    inicpp::test::load_many_checks();
+    inicpp::test::number_format_checks();
+    inicpp::test::ordered_map_checks();
+    inicpp::test::parse_checks();
+    inicpp::test::parse_stats_checks();
+    inicpp::test::read_parallel_checks();
+    inicpp::test::reload_checks();
+    inicpp::test::scanner_checks();
+    inicpp::test::shared_config_checks();
+    inicpp::test::try_as_checks();
+    inicpp::test::write_file_checks();
+
     std::istringstream input(R"(
         [section]
         key1=value1 ; this is a comment
@@ -44,4 +65,6 @@ int main() {
     section1["key5"] = 64;
 
     std::cout << "\n" << ini << std::flush;
+
+    return inicpp::test::failures() == 0 ? 0 : 1;
 }
\ No newline at end of file
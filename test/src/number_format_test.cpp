@@ -0,0 +1,55 @@
+#include "check.h"
+
+#include <ini-cpp/ini.hpp>
+
+#include <cmath>
+#include <limits>
+#include <string>
+
+namespace inicpp::test {
+    namespace {
+        // Equal including the sign of zero
+        template<typename T>
+        bool same(T a, T b) { return a == b && std::signbit(a) == std::signbit(b); }
+
+        // Assigns @p num, then reads it back from the value itself and from the text written for it
+        template<typename T>
+        bool round_trips(T num) {
+            ini cfg;
+            cfg["n"]["v"] = num;
+            if (!same(cfg["n"]["v"].as<T>(), num)) return false;
+
+            std::string text;
+            cfg.write(text);
+            ini reread;
+            reread.read(text);
+            return same(reread["n"]["v"].as<T>(), num);
+        }
+    }
+
+    void number_format_checks() {
+        for (float f : { 2.718281828459045f, 0.1f, -0.0f, 1e-45f, 3.4028235e38f, std::numeric_limits<float>::min() })
+            INICPP_CHECK(round_trips(f));
+
+        for (double d : { 0.1, 1e300, -0.0, 2.718281828459045, 1.0 / 3.0, std::numeric_limits<double>::denorm_min(), std::numeric_limits<double>::max() })
+            INICPP_CHECK(round_trips(d));
+
+        for (long double ld : { 0.1L, -0.0L, 1e4000L / 1e3990L, 1.0L / 3.0L, std::numeric_limits<long double>::max(), std::numeric_limits<long double>::min() })
+            INICPP_CHECK(round_trips(ld));
+
+        for (long long i : { 0LL, -1LL, std::numeric_limits<long long>::min(), std::numeric_limits<long long>::max() })
+            INICPP_CHECK(round_trips(i));
+        INICPP_CHECK(round_trips(std::numeric_limits<unsigned long long>::max()));
+
+        // shortest form, with no exponent or padding it does not need
+        ini cfg;
+        cfg["n"]["v"] = 0.1;
+        INICPP_CHECK(cfg["n"]["v"].as<std::string>() == "0.1");
+        cfg["n"]["v"] = 2.718281828459045f;
+        INICPP_CHECK(cfg["n"]["v"].as<std::string>() == "2.7182817");
+        cfg["n"]["v"] = 1e300;
+        INICPP_CHECK(cfg["n"]["v"].as<std::string>() == "1e+300");
+        cfg["n"]["v"] = -0.0;
+        INICPP_CHECK(cfg["n"]["v"].as<std::string>() == "-0");
+    }
+}
@@ -0,0 +1,67 @@
+#include "check.h"
+
+#include <ini-cpp/detail/ordered_map.h>
+
+#include <string>
+#include <vector>
+
+namespace inicpp::test {
+    namespace {
+        typedef detail::ordered_map<std::string, int> map_type;
+
+        std::vector<int> values(const map_type& map) {
+            std::vector<int> result;
+            for (auto const& pair : map) result.push_back(pair.second);
+            return result;
+        }
+    }
+
+    void ordered_map_checks() {
+        // erasing by key keeps the order of the others and their addresses, through compactions as well
+        map_type map;
+        for (int i = 0; i < 100; i++) map[std::to_string(i)] = i;
+        const int* const kept = &map.at("99");
+        for (int i = 0; i < 100; i += 2) INICPP_CHECK(map.erase(std::to_string(i)) == 1);
+        INICPP_CHECK(map.erase("0") == 0);
+        INICPP_CHECK(map.size() == 50);
+        INICPP_CHECK(&map.at("99") == kept);
+        INICPP_CHECK(!map.contains("42") && map.find("42") == map.end());
+        INICPP_CHECK(map.contains("43") && map.find("43")->second == 43);
+
+        std::vector<int> odd;
+        for (int i = 1; i < 100; i += 2) odd.push_back(i);
+        INICPP_CHECK(values(map) == odd);
+
+        // an erased key is inserted again at the end
+        map["42"] = 42;
+        INICPP_CHECK(map.back().second == 42 && map.size() == 51);
+
+        // erasing through iterators visits every element once, even when an erase compacts the entries
+        map_type filtered;
+        for (int i = 0; i < 200; i++) filtered[std::to_string(i)] = i;
+        int visited = 0;
+        for (auto it = filtered.begin(); it != filtered.end();) {
+            visited++;
+            if (it->second % 3 != 0) it = filtered.erase(it);
+            else ++it;
+        }
+        INICPP_CHECK(visited == 200);
+        INICPP_CHECK(filtered.size() == 67);
+        std::vector<int> thirds;
+        for (int i = 0; i < 200; i += 3) thirds.push_back(i);
+        INICPP_CHECK(values(filtered) == thirds);
+        for (int i : thirds) INICPP_CHECK(filtered.at(std::to_string(i)) == i);
+
+        // copies and moves skip the tombstones
+        map_type copy(map);
+        INICPP_CHECK(values(copy) == values(map) && copy.size() == map.size());
+        map_type moved(std::move(copy));
+        INICPP_CHECK(values(moved) == values(map) && moved.find("43")->second == 43);
+
+        // popping everything leaves an empty, usable map
+        while (!map.empty()) map.pop_front();
+        INICPP_CHECK(map.begin() == map.end() && !map.contains("99"));
+        map["a"] = 1;
+        INICPP_CHECK(map.size() == 1 && map.front().second == 1);
+    }
+}
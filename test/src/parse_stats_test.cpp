@@ -0,0 +1,59 @@
+#include "check.h"
+
+#include <ini-cpp/ini.hpp>
+#include <ini-cpp/counting_resource.hpp>
+#include <ini-cpp/parse_stats.hpp>
+
+#include <string>
+
+namespace inicpp::test {
+    void parse_stats_checks() {
+        std::string const text = "; head\n[a]\nk=1\nk=2 ; trailing\n[b]\nx=1\n[a]\nj=3\nk=4\n# end\n";
+
+        // every counter of a read, on a fixed input
+        {
+            ini cfg;
+            parse_stats stats;
+            cfg.read(text, stats);
+            INICPP_CHECK(stats.bytes == text.length() && stats.lines == 10);
+            INICPP_CHECK(stats.comments == 3);
+            INICPP_CHECK(stats.sections_created == 2 && stats.sections_reopened == 1 && stats.sections_unchanged == 0);
+            INICPP_CHECK(stats.keys_created == 3 && stats.keys_overwritten == 2);
+            INICPP_CHECK(stats.resource_allocations == 0 && stats.resource_bytes == 0);
+            INICPP_CHECK(stats.tokenize_time.count() > 0 && stats.total_time >= stats.prepare_time + stats.tokenize_time + stats.insert_time);
+
+            // reading again overwrites every key and creates nothing; the stats are reset first
+            cfg.read(text, stats);
+            INICPP_CHECK(stats.sections_created == 0 && stats.sections_reopened == 3);
+            INICPP_CHECK(stats.keys_created == 0 && stats.keys_overwritten == 5);
+        }
+
+        // allocations are counted when the ini allocates from a counting_resource
+        {
+            counting_resource resource;
+            ini cfg{ ini::allocator_type(&resource) };
+            std::size_t const before = resource.allocations();
+            parse_stats stats;
+            cfg.read(text, stats);
+            INICPP_CHECK(stats.resource_allocations > 0 && stats.resource_allocations == resource.allocations() - before);
+            INICPP_CHECK(stats.resource_bytes > 0 && stats.resource_bytes <= resource.bytes_allocated());
+            INICPP_CHECK(cfg["a"]["k"].as<int>() == 4);
+        }
+
+        // a reload keeps the sections whose text did not change
+        {
+            ini cfg;
+            parse_stats stats;
+            cfg.reload(std::string("[a]\nk=1\n[b]\nx=1\n[c]\ny=1\n"), stats);
+            INICPP_CHECK(stats.sections_unchanged == 0 && stats.sections_created == 3);
+            INICPP_CHECK(stats.tokenize_time.count() > 0 && stats.total_time >= stats.prepare_time + stats.tokenize_time + stats.insert_time);
+
+            cfg.reload(std::string("[a]\nk=1\n[b]\nx=2\n[c]\ny=1\n"), stats);
+            INICPP_CHECK(stats.sections_unchanged == 2 && stats.keys_created == 1);
+            INICPP_CHECK(cfg["b"]["x"].as<int>() == 2);
+
+            cfg.reload(std::string("[a]\nk=1\n[b]\nx=2\n[c]\ny=1\n"), stats);
+            INICPP_CHECK(stats.sections_unchanged == 3 && stats.keys_created == 0 && stats.sections_created == 0);
+        }
+    }
+}
@@ -0,0 +1,87 @@
+#include "check.h"
+
+#include <ini-cpp/parser.hpp>
+
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace inicpp::test {
+    namespace {
+        // Records every callback, and keeps going after errors
+        struct recorder : parse_handler {
+            std::vector<std::string> events;
+            std::size_t sections = 0, keys = 0, comments = 0, errors = 0;
+
+            void on_section(std::string_view name) override {
+                sections++;
+                events.push_back("[" + std::string(name) + "]");
+            }
+
+            void on_key_value(std::string_view key, std::string_view value) override {
+                keys++;
+                events.push_back(std::string(key) + "=" + std::string(value));
+            }
+
+            void on_comment(std::string_view comment) override {
+                comments++;
+                events.push_back(std::string(comment));
+            }
+
+            void on_error(const parse_error& error) override {
+                errors++;
+                events.push_back("error " + to_string(error) + " @" + std::to_string(error.offset));
+            }
+        };
+
+        recorder parse_stream(const std::string& text) {
+            std::istringstream in(text);
+            recorder r;
+            parse(in, r);
+            return r;
+        }
+    }
+
+    void parse_checks() {
+        // one callback per token, with trimmed views
+        {
+            std::string const text = "; leading\n[a]\n k = 1 \nj=2 # trailing\n\n[ b ]\n# note\nk=\nbroken\n";
+            recorder r;
+            parse(text, r);
+            INICPP_CHECK(r.sections == 2 && r.keys == 3 && r.comments == 3 && r.errors == 1);
+            INICPP_CHECK((r.events == std::vector<std::string>{
+                "; leading", "[a]", "k=1", "j=2", "# trailing", "[b]", "# note", "k=", "error 9:7 Expected delimeter before end of line @54" }));
+            INICPP_CHECK(r.events[2] == "k=1" && r.events[5] == "[b]");
+            INICPP_CHECK(parse_stream(text).events == r.events);
+
+            recorder empty;
+            parse(std::string_view(), empty);
+            INICPP_CHECK(empty.events.empty());
+        }
+
+        // lines that straddle the 64 KB chunks of a stream, and one longer than a chunk, are tokenized as a whole
+        {
+            std::string text;
+            for (int i = 0; text.length() < 300 * 1024; i++) {
+                if (i % 50 == 0) text += "[section" + std::to_string(i) + "]\n";
+                text += "key" + std::to_string(i) + "=" + std::string(static_cast<std::size_t>(i * 37 % 500), 'v') + "\n";
+                if (i % 7 == 0) text += "; comment " + std::to_string(i) + "\n";
+                if (i == 500) text += "long=" + std::string(100 * 1024, 'x') + "\n";
+            }
+            text += "last=no newline";
+
+            recorder whole;
+            parse(text, whole);
+            recorder const streamed = parse_stream(text);
+            INICPP_CHECK(whole.errors == 0 && whole.keys > 700);
+            INICPP_CHECK(streamed.events == whole.events);
+            INICPP_CHECK(streamed.events.back() == "last=no newline");
+
+            // errors past a boundary keep their line and offset counted from the start of the stream
+            std::string const broken = text + "\nbroken\n[c]\nk=v\n";
+            recorder const whole_broken = [&] { recorder r; parse(broken, r); return r; }();
+            recorder const streamed_broken = parse_stream(broken);
+            INICPP_CHECK(whole_broken.errors == 1 && streamed_broken.events == whole_broken.events);
+        }
+    }
+}
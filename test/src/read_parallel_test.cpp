@@ -0,0 +1,81 @@
+#include "check.h"
+
+#include <ini-cpp/ini.hpp>
+#include <ini-cpp/parser_exception.hpp>
+#include <ini-cpp/thread_pool.hpp>
+
+#include <cstddef>
+#include <random>
+#include <string>
+
+namespace inicpp::test {
+    namespace {
+        // About @p size bytes of sections that repeat across the whole text, with a broken line after @p error_at bytes
+        std::string generate(std::size_t size, std::size_t error_at = std::string::npos) {
+            std::mt19937 rng(7);
+            std::string text = "; preamble\n\n";
+            while (text.size() < size) {
+                text += (rng() % 3 == 0 ? "  [s" : "[s") + std::to_string(rng() % 50) + "]\n";
+                for (int keys = rng() % 200; keys > 0; keys--) {
+                    text += "k" + std::to_string(rng() % 100) + " = v" + std::to_string(rng()) + (rng() % 4 == 0 ? " ; c\n" : "\n");
+                    if (text.size() > error_at) {
+                        text += "broken\n";
+                        error_at = std::string::npos;
+                    }
+                }
+            }
+            return text;
+        }
+
+        // The contents and section order of @p config
+        std::string dump(const ini& config) {
+            std::string result;
+            config.write(result);
+            for (auto const& section : config) result += section.get_name() + ",";
+            return result;
+        }
+
+        // Reads @p text serially and in parallel into two ini made by @p make, which must end up equal
+        template<typename Make>
+        void compare(const std::string& text, thread_pool& pool, Make make) {
+            ini serial = make(), parallel = make();
+            std::string serial_error, parallel_error;
+            try {
+                serial.read(text);
+            } catch (const parser_exception& e) {
+                serial_error = e.what();
+            }
+            try {
+                parallel.read_parallel(text, pool);
+            } catch (const parser_exception& e) {
+                parallel_error = e.what();
+            }
+            INICPP_CHECK(serial_error == parallel_error);
+            INICPP_CHECK(dump(serial) == dump(parallel));
+        }
+    }
+
+    void read_parallel_checks() {
+        thread_pool pool(4);
+        std::size_t const size = std::size_t(2) << 20;
+
+        // large enough to be split, with sections repeated across chunks
+        compare(generate(size), pool, [] { return ini(); });
+
+        // an error stops at the same line with the same message, keeping the sections before it
+        std::string const broken = generate(size, size / 2);
+        compare(broken, pool, [] { return ini(); });
+        INICPP_CHECK_THROWS(ini().read_parallel(broken, pool), parser_exception);
+
+        // sections that already exist are merged into, from an arena as well
+        compare(generate(size), pool, [] {
+            ini config = ini::with_arena();
+            config["s3"]["x"] = 1;
+            config["other"]["y"] = 2;
+            return config;
+        });
+
+        // small buffers are read on the calling thread
+        compare("[a]\nk=1\n[b]\nk=2\n[a]\nk=3\n", pool, [] { return ini(); });
+    }
+}
@@ -0,0 +1,71 @@
+#include "check.h"
+
+#include <ini-cpp/ini.hpp>
+#include <ini-cpp/parser_exception.hpp>
+
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <system_error>
+
+namespace inicpp::test {
+    void reload_checks() {
+        const std::string text = "[a]\nk=1\n[b]\nk=2\n[c]\nk=3\n";
+
+        // unchanged sections are kept as they are, changed ones get their new values
+        ini cfg;
+        cfg.reload(text);
+        const ini_value* const kept = &cfg["a"]["k"];
+        cfg.reload(std::string("[a]\nk=1\n[b]\nk=20\n[d]\nk=4\n"));
+        INICPP_CHECK(&cfg["a"]["k"] == kept);
+        INICPP_CHECK(cfg["b"]["k"].as<int>() == 20);
+        INICPP_CHECK(cfg["d"]["k"].as<int>() == 4);
+        INICPP_CHECK(!cfg.contains("c"));
+
+        // a section modified through the API is parsed again, whichever way the value was changed
+        cfg.reload(text);
+        cfg["b"]["k"] = 5;
+        cfg.reload(text);
+        INICPP_CHECK(cfg["b"]["k"].as<int>() == 2);
+
+        cfg["b"]["k"].set_value("6");
+        cfg.reload(text);
+        INICPP_CHECK(cfg["b"]["k"].as<int>() == 2);
+
+        cfg["b"]["k"] = cfg["a"]["k"];
+        INICPP_CHECK(cfg["b"]["k"].as<int>() == 1);
+        cfg.reload(text);
+        INICPP_CHECK(cfg["b"]["k"].as<int>() == 2);
+
+        cfg["b"]["k"] = ini_value(std::string("7"));
+        cfg.reload(text);
+        INICPP_CHECK(cfg["b"]["k"].as<int>() == 2);
+
+        // assigning a value does not move it into the source's section
+        cfg["c"]["k"] = cfg["a"]["k"];
+        cfg["c"]["k"] = 8;
+        cfg.reload(text);
+        INICPP_CHECK(cfg["a"]["k"].as<int>() == 1 && cfg["c"]["k"].as<int>() == 3);
+
+        // a buffer that cannot be parsed leaves the ini unchanged
+        INICPP_CHECK_THROWS(cfg.reload(std::string("[a]\nk=9\n[b\n")), parser_exception);
+        INICPP_CHECK(cfg["a"]["k"].as<int>() == 1 && cfg["b"]["k"].as<int>() == 2);
+
+        // repeated headers are merged like read does
+        cfg.reload(std::string("[a]\nx=1\n[a]\ny=2\n"));
+        INICPP_CHECK(cfg["a"]["x"].as<int>() == 1 && cfg["a"]["y"].as<int>() == 2 && !cfg.contains("b"));
+
+        // a file rewritten in place, shorter than before, is reloaded from what it holds now
+        std::filesystem::path const path = std::filesystem::temp_directory_path() / "ini-cpp-reload-test.ini";
+        std::ofstream(path, std::ios::binary | std::ios::trunc) << text;
+        cfg.reload_file(path.string());
+        INICPP_CHECK(cfg["c"]["k"].as<int>() == 3);
+        std::ofstream(path, std::ios::binary | std::ios::trunc) << "[a]\nk=1\n";
+        cfg.reload_file(path.string());
+        INICPP_CHECK(cfg["a"]["k"].as<int>() == 1 && !cfg.contains("b") && !cfg.contains("c"));
+
+        std::filesystem::remove(path);
+        INICPP_CHECK_THROWS(cfg.reload_file(path.string()), std::system_error);
+        INICPP_CHECK(cfg["a"]["k"].as<int>() == 1);
+    }
+}
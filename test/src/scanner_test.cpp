@@ -0,0 +1,47 @@
+#include "check.h"
+
+#include "scanner.h"
+
+#include <random>
+#include <string>
+
+namespace inicpp::test {
+    void scanner_checks() {
+        using detail::byte_scanner;
+        byte_scanner::kernel const kernels[] = { byte_scanner::kernel::sse2, byte_scanner::kernel::avx2 };
+        INICPP_CHECK(byte_scanner::supported(byte_scanner::kernel::scalar));
+
+        std::mt19937 random(12345);
+        for (std::size_t count = 1; count <= byte_scanner::max_vector_bytes + 1; count++) {
+            for (int round = 0; round < 50; round++) {
+                // a set of distinct bytes, including ones with the high bit set
+                std::string set;
+                while (set.length() < count) {
+                    char const c = static_cast<char>(random() & 0xff);
+                    if (set.find(c) == std::string::npos) set += c;
+                }
+                byte_scanner const scanner(set);
+
+                // lengths around and between the 16 and 32 byte blocks, with hits that are sparse, dense or absent
+                std::size_t const length = random() % 200;
+                unsigned const density = round % 3 == 0 ? 0 : round % 3 == 1 ? 64 : 4;
+                std::string buffer(length, '\0');
+                for (char& c : buffer) {
+                    if (density && random() % density == 0) c = set[random() % set.length()];
+                    else do c = static_cast<char>(random() & 0xff); while (scanner.contains(c));
+                }
+
+                // every start offset, so that loads are unaligned and tails of every length are left
+                const char* const end = buffer.data() + buffer.length();
+                for (std::size_t offset = 0; offset <= length; offset++) {
+                    const char* const begin = buffer.data() + offset;
+                    const char* const expected = scanner.find_with(byte_scanner::kernel::scalar, begin, end);
+                    for (byte_scanner::kernel k : kernels) {
+                        if (byte_scanner::supported(k)) INICPP_CHECK(scanner.find_with(k, begin, end) == expected);
+                    }
+                    INICPP_CHECK(scanner.find(begin, end) == expected);
+                }
+            }
+        }
+    }
+}
@@ -0,0 +1,103 @@
+#include "check.h"
+
+#include <ini-cpp/shared_config.hpp>
+
+#include <atomic>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <system_error>
+#include <thread>
+#include <vector>
+
+namespace inicpp::test {
+    namespace {
+        ini with_value(int value) {
+            ini cfg;
+            cfg["a"]["k"] = value;
+            return cfg;
+        }
+    }
+
+    void shared_config_checks() {
+        // every publish bumps the version, starting with the initial snapshot
+        {
+            shared_config config;
+            INICPP_CHECK(config.version() == 1 && config.load() && config.load()->empty());
+
+            config.publish(with_value(1));
+            INICPP_CHECK(config.version() == 2 && (*config.load())["a"]["k"].as<int>() == 1);
+
+            // a null snapshot publishes an empty ini
+            config.publish(shared_config::snapshot());
+            INICPP_CHECK(config.version() == 3 && config.load() && config.load()->empty());
+        }
+
+        // a pinned snapshot outlives the publish that replaces it
+        {
+            shared_config config(with_value(1));
+            shared_config::snapshot const pinned = config.load();
+            config.publish(with_value(2));
+            INICPP_CHECK((*pinned)["a"]["k"].as<int>() == 1 && pinned.use_count() == 1);
+            INICPP_CHECK((*config.load())["a"]["k"].as<int>() == 2);
+        }
+
+        // a reader keeps its snapshot until something is published, then picks up the new one
+        {
+            shared_config config(with_value(1));
+            shared_config::reader reader = config.make_reader();
+            const ini* const first = reader.get().get();
+            INICPP_CHECK(reader.get().get() == first && (*reader)["a"]["k"].as<int>() == 1);
+
+            config.publish(with_value(2));
+            INICPP_CHECK(reader.get().get() != first && reader->find("a")["k"].as<int>() == 2);
+
+            config.publish(shared_config::snapshot());
+            INICPP_CHECK(reader.get() && reader->empty());
+        }
+
+        // read_file publishes the file, and keeps the current snapshot if it cannot be read
+        {
+            std::filesystem::path const path = std::filesystem::temp_directory_path() / "ini-cpp-shared-config-test.ini";
+            std::ofstream(path, std::ios::binary | std::ios::trunc) << "[a]\nk=5\n";
+            shared_config config;
+            config.read_file(path.string());
+            INICPP_CHECK(config.version() == 2 && (*config.load())["a"]["k"].as<int>() == 5);
+
+            std::filesystem::remove(path);
+            INICPP_CHECK_THROWS(config.read_file(path.string()), std::system_error);
+            INICPP_CHECK(config.version() == 2 && (*config.load())["a"]["k"].as<int>() == 5);
+        }
+
+        // readers on several threads only ever see whole snapshots, in publish order, and end up on the last one
+        {
+            constexpr int publishes = 2000;
+            shared_config config(with_value(0));
+            std::atomic<bool> done{ false };
+            std::atomic<int> failures{ 0 };
+
+            std::vector<std::thread> readers;
+            for (int t = 0; t < 4; t++) {
+                readers.emplace_back([&] {
+                    shared_config::reader reader = config.make_reader();
+                    int last = 0;
+                    for (;;) {
+                        bool const finished = done.load(std::memory_order_acquire);
+                        int const value = (*reader)["a"]["k"].as<int>();
+                        if (value < last) failures++;
+                        last = value;
+                        if (finished) break;
+                    }
+                    if (last != publishes) failures++;
+                });
+            }
+
+            for (int i = 1; i <= publishes; i++) config.publish(with_value(i));
+            done.store(true, std::memory_order_release);
+            for (std::thread& thread : readers) thread.join();
+
+            INICPP_CHECK(failures == 0);
+            INICPP_CHECK(config.version() == publishes + 1);
+        }
+    }
+}
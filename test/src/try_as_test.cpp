@@ -0,0 +1,60 @@
+#include "check.h"
+
+#include <ini-cpp/frozen_ini.hpp>
+#include <ini-cpp/ini.hpp>
+
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+
+namespace inicpp::test {
+    void try_as_checks() {
+        ini config;
+        config.read(std::string("[s]\nint=42\nnegative=-7\nsuffix=4x\nhuge=1e999\nreal=3.5\nbig=70000\ntext=x\nempty=\n"));
+        ini_section& s = config["s"];
+
+        // numbers have to span the whole value
+        int number = 9;
+        INICPP_CHECK(s["int"].try_as(number) == std::errc() && number == 42);
+        INICPP_CHECK(s["negative"].try_as<int>() == -7);
+        INICPP_CHECK(s["suffix"].try_as(number) == std::errc::invalid_argument);
+        INICPP_CHECK(s["text"].try_as(number) == std::errc::invalid_argument);
+        INICPP_CHECK(s["empty"].try_as(number) == std::errc::invalid_argument);
+        INICPP_CHECK(s["real"].try_as(number) == std::errc::invalid_argument);
+        INICPP_CHECK(s["real"].try_as<double>() == 3.5);
+        INICPP_CHECK(!s["suffix"].try_as<int>().has_value());
+
+        // numbers that do not fit into the type
+        short narrow = 0;
+        INICPP_CHECK(s["big"].try_as(narrow) == std::errc::result_out_of_range);
+        INICPP_CHECK(s["int"].try_as(narrow) == std::errc() && narrow == 42);
+        INICPP_CHECK(s["negative"].try_as<unsigned>() == std::nullopt);
+        INICPP_CHECK(s["huge"].try_as<double>() == std::nullopt);
+        INICPP_CHECK(s["big"].try_as<std::int32_t>() == 70000);
+
+        // a key without a value
+        INICPP_CHECK(s["missing"].try_as(number) == std::errc::invalid_argument);
+
+        // strings and characters always convert
+        INICPP_CHECK(s["text"].try_as<std::string>() == std::string("x"));
+        INICPP_CHECK(s["text"].try_as<char>() == 'x');
+
+        // as reports the same failures with exceptions
+        INICPP_CHECK_THROWS(s["big"].as<short>(), std::out_of_range);
+        INICPP_CHECK_THROWS(s["text"].as<int>(), std::invalid_argument);
+
+        // a cached conversion does not leak into another type or a changed value
+        INICPP_CHECK(s["big"].as<long>() == 70000);
+        INICPP_CHECK(s["big"].try_as(narrow) == std::errc::result_out_of_range);
+        s["big"] = 12;
+        INICPP_CHECK(s["big"].try_as(narrow) == std::errc() && narrow == 12);
+
+        // frozen values convert the same way
+        frozen_ini const frozen = config.freeze();
+        INICPP_CHECK(frozen["s"]["int"].try_as<long>() == 42L);
+        INICPP_CHECK(frozen["s"]["suffix"].try_as(number) == std::errc::invalid_argument);
+        INICPP_CHECK(frozen["s"]["absent"].try_as(number) == std::errc::invalid_argument);
+        INICPP_CHECK(frozen["s"]["text"].try_as<std::string>() == std::string("x"));
+    }
+}
@@ -0,0 +1,97 @@
+#include "check.h"
+
+#include <ini-cpp/ini.hpp>
+
+#include "replace_file.h"
+
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <sstream>
+#include <string>
+#include <system_error>
+
+#ifndef _WIN32
+#   include <sys/stat.h>
+#endif
+
+namespace inicpp::test {
+    namespace {
+        std::string contents(const std::filesystem::path& path) {
+            std::ifstream in(path, std::ios::binary);
+            return std::string(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+        }
+
+        // Number of entries in @p directory
+        std::size_t entries(const std::filesystem::path& directory) {
+            return static_cast<std::size_t>(std::distance(std::filesystem::directory_iterator(directory), std::filesystem::directory_iterator()));
+        }
+    }
+
+    void write_file_checks() {
+        std::filesystem::path const directory = std::filesystem::temp_directory_path() / "ini-cpp-write-file-test";
+        std::error_code ec;
+        std::filesystem::remove_all(directory, ec);
+        std::filesystem::create_directories(directory);
+        std::filesystem::path const path = directory / "out.ini";
+
+        ini cfg;
+        cfg.read(std::string("[server]\nhost=example.org\nport=8080\n[empty]\n[paths]\nroot=/var/www\nlog=\n"));
+        cfg["server"]["timeout"] = 2.5;
+        std::ostringstream stream;
+        stream << cfg;
+
+        // the sized string writer and the file writer produce exactly what operator<< does
+        std::string text = "stale contents";
+        cfg.write(text);
+        INICPP_CHECK(text == stream.str());
+
+        cfg.write_file(path.string());
+        INICPP_CHECK(contents(path) == stream.str());
+        INICPP_CHECK(entries(directory) == 1);
+
+        // replacing a file swaps its contents, and what was written reads back the same
+        cfg["server"]["port"] = 9090;
+        cfg.write_file(path.string());
+        ini reread;
+        reread.read_file(path.string());
+        INICPP_CHECK(reread["server"]["port"].as<int>() == 9090 && reread["server"]["host"].as<std::string>() == "example.org");
+        cfg.write(text);
+        INICPP_CHECK(contents(path) == text);
+
+        ini empty;
+        empty.write(text);
+        INICPP_CHECK(text.empty());
+        empty.write_file(path.string());
+        INICPP_CHECK(contents(path).empty());
+        cfg.write_file(path.string());
+        cfg.write(text);
+
+#ifndef _WIN32
+        // an existing file keeps its mode, a new one gets 0666 minus the umask
+        INICPP_CHECK(::chmod(path.c_str(), 0640) == 0);
+        cfg.write_file(path.string());
+        struct stat st;
+        INICPP_CHECK(::stat(path.c_str(), &st) == 0 && (st.st_mode & 07777) == 0640);
+
+        ::mode_t const previous = ::umask(027);
+        std::filesystem::path const fresh = directory / "fresh.ini";
+        cfg.write_file(fresh.string());
+        ::umask(previous);
+        INICPP_CHECK(::stat(fresh.c_str(), &st) == 0 && (st.st_mode & 07777) == 0640);
+        std::filesystem::remove(fresh);
+#endif
+
+        // a directory that does not exist fails without creating anything
+        INICPP_CHECK_THROWS(cfg.write_file((directory / "missing" / "out.ini").string()), std::system_error);
+        INICPP_CHECK(entries(directory) == 1 && contents(path) == text);
+
+        // a failed rename removes the temporary file and leaves the target as it was
+        std::filesystem::path const blocked = directory / "blocked";
+        std::filesystem::create_directories(blocked / "inner");
+        INICPP_CHECK_THROWS(detail::replace_file(blocked.string(), "x=1\n"), std::system_error);
+        INICPP_CHECK(entries(directory) == 2 && std::filesystem::is_directory(blocked / "inner"));
+
+        std::filesystem::remove_all(directory, ec);
+    }
+}